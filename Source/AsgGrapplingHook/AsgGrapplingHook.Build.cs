@@ -76,6 +76,7 @@ public class AsgGrapplingHook : ModuleRules
 		
 		PrivateDependencyModuleNames.AddRange(new string[] {
 			// ... add private dependencies that you statically link with here ...	
+			"AbstractInstance",
 		});
 		
 		DynamicallyLoadedModuleNames.AddRange(new string[] {
@@ -4,6 +4,8 @@
 
 #define LOCTEXT_NAMESPACE "FAsgGrapplingHookModule"
 
+DEFINE_LOG_CATEGORY(LogAsgGrapple);
+
 void FAsgGrapplingHookModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -0,0 +1,22 @@
+﻿#include "AsgGrapplingHookStats.h"
+
+DEFINE_STAT(STAT_AsgGrapple_ServerTick);
+DEFINE_STAT(STAT_AsgGrapple_ClientTick);
+DEFINE_STAT(STAT_AsgGrapple_TensionForce);
+DEFINE_STAT(STAT_AsgGrapple_TensionBatch);
+DEFINE_STAT(STAT_AsgGrapple_PullImpulses);
+DEFINE_STAT(STAT_AsgGrapple_UpgradeValue);
+DEFINE_STAT(STAT_AsgGrapple_CablePathTrace);
+DEFINE_STAT(STAT_AsgGrapple_CrosshairTrace);
+DEFINE_STAT(STAT_AsgGrapple_SendCableState);
+
+DEFINE_STAT(STAT_AsgGrapple_ActiveCables);
+DEFINE_STAT(STAT_AsgGrapple_AttachedCables);
+DEFINE_STAT(STAT_AsgGrapple_PulledBodies);
+DEFINE_STAT(STAT_AsgGrapple_RejectedRpcs);
+DEFINE_STAT(STAT_AsgGrapple_RpcsPerSecond);
+DEFINE_STAT(STAT_AsgGrapple_CableStateUpdatesPerSecond);
+
+CSV_DEFINE_CATEGORY_MODULE(ASGGRAPPLINGHOOK_API, AsgGrapple, true);
+
+UE_TRACE_CHANNEL_DEFINE(AsgGrappleChannel);
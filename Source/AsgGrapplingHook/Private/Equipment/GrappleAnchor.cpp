@@ -0,0 +1,112 @@
+﻿#include "Equipment/GrappleAnchor.h"
+
+#include "AbstractInstanceManager.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/HitResult.h"
+
+void FGrappleAnchor::Reset()
+{
+	*this = FGrappleAnchor();
+}
+
+void FGrappleAnchor::SetFromHit(const FHitResult& HitResult)
+{
+	Reset();
+
+	// Abstract instances are rendered by shared instance manager and belong to static buildables, so they are
+	// anchored in world space and only their owner is remembered
+	if (FInstanceHandle InstanceHandle;
+		AAbstractInstanceManager::ResolveHit(HitResult, InstanceHandle))
+	{
+		OwnerActor = InstanceHandle.GetOwner<AActor>();
+		SetFromComponent(nullptr, HitResult.ImpactPoint);
+		return;
+	}
+
+	USceneComponent* HitComponent = HitResult.GetComponent();
+	BoneName = HitResult.BoneName;
+	if (Cast<UInstancedStaticMeshComponent>(HitComponent))
+	{
+		InstanceIndex = HitResult.Item;
+	}
+	SetFromComponent(HitComponent, HitResult.ImpactPoint);
+}
+
+void FGrappleAnchor::SetFromComponent(USceneComponent* InComponent, const FVector& Location)
+{
+	bSet = true;
+	AttachLocation = Location;
+	if (InComponent)
+	{
+		OwnerActor = InComponent->GetOwner();
+	}
+
+	// Static geometry never moves, so there is no point resolving it every tick
+	bRelative = InComponent && InComponent->Mobility == EComponentMobility::Movable;
+	if (!bRelative)
+	{
+		Component = nullptr;
+		BoneName = NAME_None;
+		InstanceIndex = INDEX_NONE;
+		return;
+	}
+
+	Component = InComponent;
+	LocalOffset = GetAnchorSpaceTransform(InComponent).InverseTransformPosition(Location);
+	const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(InComponent);
+	bSimulatingPhysics = Primitive && Primitive->IsSimulatingPhysics(BoneName);
+}
+
+FBodyInstance* FGrappleAnchor::GetBodyInstance() const
+{
+	UPrimitiveComponent* Primitive = bRelative ? Cast<UPrimitiveComponent>(Component.Get()) : nullptr;
+	return Primitive ? Primitive->GetBodyInstance(BoneName) : nullptr;
+}
+
+bool FGrappleAnchor::operator==(const FGrappleAnchor& Other) const
+{
+	return bSet == Other.bSet && bRelative == Other.bRelative && bSimulatingPhysics == Other.bSimulatingPhysics
+		&& Component == Other.Component && BoneName == Other.BoneName && InstanceIndex == Other.InstanceIndex
+		&& LocalOffset == Other.LocalOffset && AttachLocation == Other.AttachLocation;
+}
+
+bool FGrappleAnchor::IsLost() const
+{
+	// Weak pointer is null on clients that can't resolve the component; only stale pointer means it's gone
+	return (bRelative && Component.IsStale()) || OwnerActor.IsStale();
+}
+
+FVector FGrappleAnchor::GetWorldLocation() const
+{
+	if (!bRelative)
+	{
+		return AttachLocation;
+	}
+	const USceneComponent* AnchorComponent = Component.Get();
+	if (!AnchorComponent)
+	{
+		return AttachLocation;
+	}
+	return GetAnchorSpaceTransform(AnchorComponent).TransformPosition(LocalOffset);
+}
+
+FTransform FGrappleAnchor::GetAnchorSpaceTransform(const USceneComponent* AnchorComponent) const
+{
+	if (InstanceIndex != INDEX_NONE)
+	{
+		if (const UInstancedStaticMeshComponent* Instances = Cast<UInstancedStaticMeshComponent>(AnchorComponent))
+		{
+			if (FTransform InstanceTransform;
+				Instances->GetInstanceTransform(InstanceIndex, InstanceTransform, true))
+			{
+				return InstanceTransform;
+			}
+		}
+	}
+	if (BoneName != NAME_None)
+	{
+		return AnchorComponent->GetSocketTransform(BoneName);
+	}
+	return AnchorComponent->GetComponentTransform();
+}
@@ -0,0 +1,95 @@
+﻿#include "Equipment/GrappleCablePath.h"
+
+#include "Engine/World.h"
+
+void FGrappleCablePath::Reset()
+{
+	WrapPoints.Reset();
+}
+
+void FGrappleCablePath::Restore(const TArray<FGrappleCableWrapPoint>& SavedWrapPoints)
+{
+	WrapPoints = SavedWrapPoints;
+}
+
+void FGrappleCablePath::Update(const UWorld* World, const FVector& SourceLocation, const FVector& AnchorLocation,
+	const FCollisionQueryParams& QueryParams, const FGrappleCableWrapSettings& Settings)
+{
+	// Unwind: cable is released from the last wrap point once it bends to the other side of the bend plane
+	while (WrapPoints.Num() > 0)
+	{
+		const FGrappleCableWrapPoint& Last = WrapPoints.Last();
+		const FVector PreviousPoint = WrapPoints.Num() > 1 ? WrapPoints[WrapPoints.Num() - 2].Location : AnchorLocation;
+		const FVector Bend = FVector::CrossProduct(Last.Location - PreviousPoint, SourceLocation - Last.Location);
+		if (FVector::DotProduct(Bend, Last.BendNormal) >= 0)
+		{
+			break;
+		}
+		WrapPoints.Pop(EAllowShrinking::No);
+	}
+
+	if (!World || WrapPoints.Num() >= Settings.MaxWrapPoints)
+	{
+		return;
+	}
+
+	// Wrap: sweep the free segment only, stopping short of the force point so its own surface is not hit
+	const FVector ForcePoint = GetForcePoint(AnchorLocation);
+	const FVector FreeSegment = ForcePoint - SourceLocation;
+	const float FreeSegmentLength = FreeSegment.Size();
+	if (FreeSegmentLength <= Settings.MinSegmentLength * 2)
+	{
+		return;
+	}
+	const FVector SweepEnd = ForcePoint - FreeSegment / FreeSegmentLength * Settings.MinSegmentLength;
+
+	FHitResult HitResult;
+	if (!World->SweepSingleByProfile(HitResult, SourceLocation, SweepEnd, FQuat::Identity, "Projectile",
+		FCollisionShape::MakeSphere(Settings.TraceRadius), QueryParams) || HitResult.bStartPenetrating)
+	{
+		return;
+	}
+
+	const FVector WrapLocation = HitResult.Location + HitResult.ImpactNormal * Settings.SurfaceOffset;
+	if (FVector::DistSquared(WrapLocation, ForcePoint) < FMath::Square(Settings.MinSegmentLength))
+	{
+		return;
+	}
+	const FVector BendNormal = FVector::CrossProduct(WrapLocation - ForcePoint, SourceLocation - WrapLocation).GetSafeNormal();
+	if (BendNormal.IsZero())
+	{
+		return;
+	}
+
+	FGrappleCableWrapPoint& WrapPoint = WrapPoints.AddDefaulted_GetRef();
+	WrapPoint.Location = WrapLocation;
+	WrapPoint.BendNormal = BendNormal;
+	if (WrapPoints.Num() > 1)
+	{
+		const FGrappleCableWrapPoint& Previous = WrapPoints[WrapPoints.Num() - 2];
+		WrapPoint.LengthFromFirstPoint = Previous.LengthFromFirstPoint + FVector::Distance(Previous.Location, WrapLocation);
+	}
+}
+
+FVector FGrappleCablePath::GetForcePoint(const FVector& AnchorLocation) const
+{
+	return WrapPoints.Num() > 0 ? WrapPoints.Last().Location : AnchorLocation;
+}
+
+FVector FGrappleCablePath::GetAnchorPullPoint(const FVector& SourceLocation) const
+{
+	return WrapPoints.Num() > 0 ? WrapPoints[0].Location : SourceLocation;
+}
+
+float FGrappleCablePath::GetLength(const FVector& SourceLocation, const FVector& AnchorLocation) const
+{
+	if (WrapPoints.Num() == 0)
+	{
+		return FVector::Distance(SourceLocation, AnchorLocation);
+	}
+
+	// Anchor may move (creatures, other players), so only the first segment is measured every time
+	const FGrappleCableWrapPoint& First = WrapPoints[0];
+	const FGrappleCableWrapPoint& Last = WrapPoints.Last();
+	return FVector::Distance(AnchorLocation, First.Location) + Last.LengthFromFirstPoint + FVector::Distance(Last.Location, SourceLocation);
+}
@@ -0,0 +1,43 @@
+﻿#include "Equipment/GrappleCableState.h"
+
+#include "Engine/NetSerialization.h"
+
+void FGrappleCableState::SetVelocity(const FVector& NewVelocity)
+{
+	// Same precision as SerializePackedVector<10, 24>
+	Velocity = FVector(FMath::RoundToDouble(NewVelocity.X * 10) / 10, FMath::RoundToDouble(NewVelocity.Y * 10) / 10, FMath::RoundToDouble(NewVelocity.Z * 10) / 10);
+	bHasVelocity = true;
+}
+
+void FGrappleCableState::ClearVelocity()
+{
+	Velocity = FVector::ZeroVector;
+	bHasVelocity = false;
+}
+
+bool FGrappleCableState::HasSameContents(const FGrappleCableState& Other) const
+{
+	return bHasVelocity == Other.bHasVelocity
+		&& (!bHasVelocity || Velocity == Other.Velocity);
+}
+
+bool FGrappleCableState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+
+	Ar << Sequence;
+
+	uint8 bVelocityBit = bHasVelocity ? 1 : 0;
+	Ar.SerializeBits(&bVelocityBit, 1);
+	bHasVelocity = bVelocityBit != 0;
+	if (bHasVelocity)
+	{
+		bOutSuccess &= SerializePackedVector<10, 24>(Velocity, Ar);
+	}
+	else if (Ar.IsLoading())
+	{
+		Velocity = FVector::ZeroVector;
+	}
+
+	return true;
+}
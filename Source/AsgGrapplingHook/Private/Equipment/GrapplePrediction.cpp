@@ -0,0 +1,33 @@
+﻿#include "Equipment/GrapplePrediction.h"
+
+void FGrapplePredictionHistory::Reset()
+{
+	Head = 0;
+	Num = 0;
+}
+
+void FGrapplePredictionHistory::Record(const float Time, const FVector& Velocity)
+{
+	FGrapplePredictionFrame& Frame = Frames[Head];
+	Frame.Time = Time;
+	Frame.Velocity = Velocity;
+
+	Head = (Head + 1) % Capacity;
+	Num = FMath::Min(Num + 1, Capacity);
+}
+
+const FGrapplePredictionFrame* FGrapplePredictionHistory::FindClosestToTime(const float Time) const
+{
+	const FGrapplePredictionFrame* Closest = nullptr;
+	for (int32 Age = 0; Age < Num; ++Age)
+	{
+		const FGrapplePredictionFrame& Frame = Frames[(Head - 1 - Age + Capacity) % Capacity];
+		if (Closest && FMath::Abs(Frame.Time - Time) > FMath::Abs(Closest->Time - Time))
+		{
+			// Frames are ordered by time, so they only get further from now on
+			break;
+		}
+		Closest = &Frame;
+	}
+	return Closest;
+}
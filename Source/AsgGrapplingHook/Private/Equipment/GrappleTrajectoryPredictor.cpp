@@ -0,0 +1,107 @@
+﻿#include "Equipment/GrappleTrajectoryPredictor.h"
+
+#include "Engine/World.h"
+
+namespace GrappleTrajectory
+{
+	// Trace user data is generation in high bits and segment index in low bits
+	constexpr uint32 SegmentBits = 16;
+	constexpr uint32 SegmentMask = (1u << SegmentBits) - 1;
+}
+
+void FGrappleTrajectoryPredictor::Start(const FGrappleTrajectoryParams& InParams)
+{
+	Params = InParams;
+	Params.TimeStep = FMath::Max(Params.TimeStep, KINDA_SMALL_NUMBER);
+	++Generation;
+
+	Points.Reset();
+	Points.Add(Params.Start);
+	NumSegmentsTraced = 0;
+	NumPendingTraces = 0;
+	bLastBatchReachesEnd = false;
+	FirstHitSegment = INDEX_NONE;
+	bComplete = false;
+	bReachable = false;
+}
+
+void FGrappleTrajectoryPredictor::Tick(UWorld* World, const FName ProfileName, const FCollisionQueryParams& QueryParams,
+	const FTraceDelegate* Delegate, const int32 SegmentsPerTick)
+{
+	if (!World || !IsStarted() || bComplete || NumPendingTraces > 0)
+	{
+		return;
+	}
+
+	const float MaxDistanceSquared = FMath::Square(Params.MaxDistance);
+	for (int32 Index = 0; Index < SegmentsPerTick && !bLastBatchReachesEnd; ++Index)
+	{
+		const int32 Segment = NumSegmentsTraced++;
+		const float EndTime = (Segment + 1) * Params.TimeStep;
+		FVector End = GetLocationAtTime(EndTime);
+
+		// Cut the path where cable would run out; projectile is retracted there
+		if (FVector::DistSquared(End, Params.Origin) > MaxDistanceSquared)
+		{
+			const FVector SegmentStart = Points.Last();
+			const FVector Direction = (End - SegmentStart).GetSafeNormal();
+			const FVector ToOrigin = SegmentStart - Params.Origin;
+			// Solve |SegmentStart + Direction * T - Origin| = MaxDistance for T
+			const float B = FVector::DotProduct(Direction, ToOrigin);
+			const float C = ToOrigin.SizeSquared() - MaxDistanceSquared;
+			const float T = -B + FMath::Sqrt(FMath::Max(0.0f, B * B - C));
+			End = SegmentStart + Direction * FMath::Max(0.0f, T);
+			bLastBatchReachesEnd = true;
+		}
+		else if (EndTime >= Params.MaxTime)
+		{
+			bLastBatchReachesEnd = true;
+		}
+
+		const uint32 UserData = (static_cast<uint32>(Generation) << GrappleTrajectory::SegmentBits) | (Segment & GrappleTrajectory::SegmentMask);
+		World->AsyncLineTraceByProfile(EAsyncTraceType::Single, Points.Last(), End, ProfileName, QueryParams, Delegate, UserData);
+		Points.Add(End);
+		++NumPendingTraces;
+	}
+}
+
+bool FGrappleTrajectoryPredictor::OnSegmentTraceCompleted(const FTraceDatum& TraceDatum)
+{
+	if (TraceDatum.UserData >> GrappleTrajectory::SegmentBits != Generation || bComplete || NumPendingTraces <= 0)
+	{
+		return false;
+	}
+
+	const int32 Segment = TraceDatum.UserData & GrappleTrajectory::SegmentMask;
+	if (TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit
+		&& (FirstHitSegment == INDEX_NONE || Segment < FirstHitSegment))
+	{
+		FirstHitSegment = Segment;
+		FirstHitLocation = TraceDatum.OutHits[0].Location;
+	}
+
+	if (--NumPendingTraces > 0)
+	{
+		return false;
+	}
+
+	if (FirstHitSegment != INDEX_NONE)
+	{
+		// Path ends at the hit; segments issued after it are dropped
+		Points.SetNum(FirstHitSegment + 1, EAllowShrinking::No);
+		Points.Add(FirstHitLocation);
+		bComplete = true;
+		bReachable = true;
+	}
+	else if (bLastBatchReachesEnd)
+	{
+		bComplete = true;
+		bReachable = false;
+	}
+	return bComplete;
+}
+
+FVector FGrappleTrajectoryPredictor::GetLocationAtTime(const float Time) const
+{
+	return Params.Start + Params.Velocity * Time + FVector(0, 0, 0.5f * Params.GravityZ * Time * Time);
+}
@@ -0,0 +1,7 @@
+﻿#include "Equipment/GrapplingHookItemState.h"
+
+bool FGrapplingHookItemState::IsRestorable() const
+{
+	return Version >= InitialVersion && Version <= LatestVersion
+		&& Hooks.ContainsByPredicate([](const FGrapplingHookSavedHook& Hook) { return Hook.IsRestorable(); });
+}
@@ -5,11 +5,23 @@
 #include "Input/FGEnhancedInputComponent.h"
 #include "Input/FGInputMappingContext.h"
 #include "FGPlayerController.h"
+#include "GameFramework/PlayerState.h"
 #include "FGSchematicManager.h"
 #include "SessionSettings/SessionSettingsManager.h"
 #include "Net/UnrealNetwork.h"
+#include "UObject/CoreNet.h"
 #include "Components/SphereComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Algo/Count.h"
+#include "Physics/GrappleTensionSolver.h"
+#include "Subsystems/GrappleProjectilePoolSubsystem.h"
+#include "Subsystems/GrapplingHookManagerSubsystem.h"
+#include "AsgGrapplingHook.h"
+#include "AsgGrapplingHookSettings.h"
+#include "AsgGrapplingHookStats.h"
+#include "Subsystems/GrapplingHookUpgradesSubsystem.h"
 
 #define BIND_ACTION(Controller, Action, TriggerEvent, FuncName) \
 	{ \
@@ -29,14 +41,32 @@ FVector2f PaniniProjection(const FVector2f OM, float d, float s)
 	return S * FVector2f(SinPhi, FMath::Lerp(TanTheta, TanTheta / CosPhi, s));
 }
 
-void UGrapplingHookRCO::ServerShootGrapple_Implementation(AGrapplingHookTool* Tool, const FVector& ShootingSourceLocation, const FVector& PlayerAimDirection)
+bool UGrapplingHookRCO::ServerShootGrapple_Validate(AGrapplingHookTool* Tool, const uint8 HookIndex, const FVector& ShootingSourceLocation, const FVector& PlayerAimDirection)
 {
+	// No legit client sends these
+	return !ShootingSourceLocation.ContainsNaN() && !PlayerAimDirection.ContainsNaN() && !PlayerAimDirection.IsNearlyZero();
+}
+
+void UGrapplingHookRCO::ServerShootGrapple_Implementation(AGrapplingHookTool* Tool, const uint8 HookIndex, const FVector& ShootingSourceLocation, const FVector& InPlayerAimDirection)
+{
+	RecordRpc();
 	if (!Tool)
 	{
 		return;
 	}
+	if (!IsToolOwnedByCaller(Tool))
+	{
+		RecordRejectedRpc(TEXT("shot with a tool of another player"));
+		return;
+	}
+	if (!IsValidHook(Tool, HookIndex))
+	{
+		RecordRejectedRpc(TEXT("shot with a hook the tool doesn't have"));
+		return;
+	}
 	
-	if (!Tool->GrappleProjectile)
+	FGrappleHook& Hook = Tool->Hooks[HookIndex];
+	if (!Hook.Projectile)
 	{
 		// Bail out if some necessary stuff doesn't exist yet (may happen for clients somehow)
 		AFGCharacterPlayer* Player = Tool->GetInstigatorCharacter();
@@ -49,17 +79,31 @@ void UGrapplingHookRCO::ServerShootGrapple_Implementation(AGrapplingHookTool* To
 		{
 			return;	
 		}
-		
-		FVector SourceLocation = ShootingSourceLocation;
-		FCollisionQueryParams QueryParams;
-		QueryParams.AddIgnoredActor(Player);
 
-		
+		// Cheap checks only, so the common path costs no extra traces
+		const UAsgGrapplingHookSettings* Settings = UAsgGrapplingHookSettings::Get();
+		const float Now = GetWorld()->GetTimeSeconds();
+		if (LastShootTime >= 0 && Now - LastShootTime < Settings->ShootMinInterval)
+		{
+			RecordRejectedRpc(TEXT("shot rate limit"));
+			return;
+		}
+		// Client's character may be ahead of or behind server's one by the distance it moves during round trip
+		const float SourceTolerance = Settings->ShootSourceTolerance + Movement->Velocity.Size() * Settings->ShootSourceLatencyAllowance;
+		if (FVector::DistSquared(ShootingSourceLocation, Player->GetActorLocation()) > FMath::Square(SourceTolerance))
+		{
+			RecordRejectedRpc(TEXT("shot source too far from character"));
+			return;
+		}
+		LastShootTime = Now;
+
+		const FVector PlayerAimDirection = InPlayerAimDirection.GetSafeNormal();
+		FVector SourceLocation = ShootingSourceLocation;
 		if (FHitResult HitResult;
 			GetWorld()->LineTraceSingleByProfile(HitResult,
 				ShootingSourceLocation,
 				ShootingSourceLocation + PlayerAimDirection * 150,
-				"Projectile", QueryParams))
+				"Projectile", Tool->AimQueryParams))
 		{
 			SourceLocation = HitResult.Location; 
 		}
@@ -72,57 +116,144 @@ void UGrapplingHookRCO::ServerShootGrapple_Implementation(AGrapplingHookTool* To
 		const FVector PlayerVelocity = Movement->Velocity;
 		const FVector PlayerVelocityOnShootingDir = PlayerVelocity.ProjectOnToNormal(PlayerAimDirection);
 		
-		Tool->GrappleProjectile = GetWorld()->SpawnActor<AGrappleProjectile>(Tool->GrappleProjectileClass);
-		Tool->GrappleProjectile->SetActorLocation(SourceLocation);
-		Tool->GrappleProjectile->SetInitialVelocity(PlayerAimDirection * Tool->GetInitialHookVelocity() + PlayerVelocityOnShootingDir);
-		Tool->GrappleProjectile->OnProjectileImpactEvent.AddDynamic(Tool, &AGrapplingHookTool::OnGrappleHitSurface);
-		Tool->OnRep_GrappleProjectile();
+		UGrappleProjectilePoolSubsystem* ProjectilePool = UGrappleProjectilePoolSubsystem::Get(GetWorld());
+		if (!ProjectilePool)
+		{
+			return;
+		}
+		Hook.Projectile = ProjectilePool->Acquire(Tool->GrappleProjectileClass, SourceLocation,
+			PlayerAimDirection * Tool->GetInitialHookVelocity() + PlayerVelocityOnShootingDir);
+		if (!Hook.Projectile)
+		{
+			return;
+		}
+		// Pooled projectiles are shared between players
+		Hook.Projectile->SetInstigator(Player);
+		AGrapplingHookTool::BindImpactEvent(Hook.Projectile->OnProjectileImpactEvent, Tool);
+		Tool->OnHookProjectileChanged(HookIndex);
 	}
 }
 
-void UGrapplingHookRCO::ServerRetractGrapple_Implementation(AGrapplingHookTool* Tool)
+void UGrapplingHookRCO::ServerRetractGrapple_Implementation(AGrapplingHookTool* Tool, const uint8 HookIndex)
 {
+	RecordRpc();
 	if (!Tool)
 	{
 		return;
 	}
-	if (Tool->GrappleProjectile)
+	if (!IsToolOwnedByCaller(Tool))
 	{
-		Tool->GrappleProjectile->Destroy();
-		Tool->GrappleProjectile = nullptr;
+		RecordRejectedRpc(TEXT("retract of a tool of another player"));
+		return;
 	}
-	Tool->bGrappleAttached = false;
-	Tool->DesiredCableLength = 0;
-	Tool->OnRep_DesiredCableLength();
-}
-
-void UGrapplingHookRCO::ServerProcessDesiredCableLengthQueries_Implementation(AGrapplingHookTool* Tool, float QueriedChange, float DeltaSeconds)
-{
-	if (!Tool)
+	if (!IsValidHook(Tool, HookIndex))
 	{
+		RecordRejectedRpc(TEXT("retract of a hook the tool doesn't have"));
 		return;
 	}
-	
-	if (!FMath::IsNearlyZero(QueriedChange))
+
+	FGrappleHook& Hook = Tool->Hooks[HookIndex];
+	if (Hook.Projectile)
 	{
-		float TargetLength = Tool->DesiredCableLength + QueriedChange * DeltaSeconds;
-		if (QueriedChange < 0)
+		if (UGrappleProjectilePoolSubsystem* ProjectilePool = UGrappleProjectilePoolSubsystem::Get(GetWorld()))
 		{
-			TargetLength = FMath::Min(Tool->DesiredCableLength, // decreasing length must never make it larger than current
-				FMath::Max(Tool->GetDistanceToGrappleForcePoint() - 600, // length cannot be too smaller than actual length to avoid slingshot situation  
-				TargetLength)); 
+			ProjectilePool->Release(Hook.Projectile);
 		}
 		else
 		{
-			TargetLength = FMath::Min(Tool->GetMaxCableLength(), TargetLength); // length cannot exceed certain maximum value
+			Hook.Projectile->Destroy();
 		}
-		
-		Tool->DesiredCableLength = TargetLength;
-		Tool->DesiredCableLengthControlQuery = 0;
-		Tool->OnRep_DesiredCableLength();
+		Hook.Projectile = nullptr;
+	}
+	Hook.Anchor.Reset();
+	Tool->OnHookAnchorChanged(HookIndex);
+	Hook.bAttached = false;
+	Tool->ResetHookSimulation(HookIndex);
+	Hook.DesiredCableLength = 0;
+	Tool->OnHookDesiredCableLengthChanged(HookIndex);
+	if (UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(GetWorld());
+		Manager && !Tool->IsGrappleAttached())
+	{
+		Manager->UnregisterTool(Tool);
+	}
+	Tool->UpdateTickState();
+}
+
+void UGrapplingHookRCO::ServerSetDesiredCableLength_Implementation(AGrapplingHookTool* Tool, const uint8 HookIndex, const uint16 Sequence, const float TargetLength)
+{
+	RecordRpc();
+	if (!Tool || !IsValidHook(Tool, HookIndex) || !Tool->Hooks[HookIndex].bAttached)
+	{
+		return;
+	}
+	if (!IsToolOwnedByCaller(Tool))
+	{
+		RecordRejectedRpc(TEXT("cable length of a tool of another player"));
+		return;
+	}
+	if (!FMath::IsFinite(TargetLength))
+	{
+		RecordRejectedRpc(TEXT("non-finite cable length"));
+		return;
+	}
+
+	// Drop updates that arrived after a newer one (wrap-around aware comparison)
+	FGrappleHook& Hook = Tool->Hooks[HookIndex];
+	if (Hook.bReceivedCableLengthInput && static_cast<int16>(Sequence - Hook.AcceptedCableLengthInputSequence) <= 0)
+	{
+		return;
+	}
+	Hook.bReceivedCableLengthInput = true;
+	Hook.AcceptedCableLengthInputSequence = Sequence;
+
+	// Clamping only depends on requested absolute value, so applying the same update twice gives the same result
+	float ClampedLength = TargetLength;
+	if (TargetLength < Hook.DesiredCableLength)
+	{
+		ClampedLength = FMath::Min(Hook.DesiredCableLength, // decreasing length must never make it larger than current
+			FMath::Max(Tool->GetDistanceToGrappleForcePoint(HookIndex) - 600, // length cannot be too smaller than actual length to avoid slingshot situation  
+			TargetLength)); 
+	}
+	else
+	{
+		ClampedLength = FMath::Min(Tool->GetMaxCableLength(), TargetLength); // length cannot exceed certain maximum value
+	}
+
+	if (!FMath::IsNearlyEqual(ClampedLength, Hook.DesiredCableLength))
+	{
+		Hook.DesiredCableLength = ClampedLength;
+		Tool->OnHookDesiredCableLengthChanged(HookIndex);
+	}
+}
+
+void UGrapplingHookRCO::RecordRpc() const
+{
+	if (UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(GetWorld()))
+	{
+		Manager->RecordRpc();
+	}
+}
+
+void UGrapplingHookRCO::RecordRejectedRpc(const TCHAR* Reason) const
+{
+	UE_LOG(LogAsgGrapple, Verbose, TEXT("Rejected grapple RPC from %s: %s"), *GetNameSafe(GetOuter()), Reason);
+	if (UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(GetWorld()))
+	{
+		Manager->RecordRejectedRpc();
 	}
 }
 
+bool UGrapplingHookRCO::IsToolOwnedByCaller(const AGrapplingHookTool* Tool) const
+{
+	const AFGCharacterPlayer* Player = Tool->GetInstigatorCharacter();
+	return Player && Player->GetController() == GetOuter();
+}
+
+bool UGrapplingHookRCO::IsValidHook(const AGrapplingHookTool* Tool, const uint8 HookIndex)
+{
+	return Tool->Hooks.IsValidIndex(HookIndex);
+}
+
 void UGrapplingHookRCO::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
@@ -136,6 +267,30 @@ float FGrapplingHookUpgradesChain::GetActiveValue(const UObject* Context) const
 }
 
 float FGrapplingHookUpgradesChain::GetActiveValue(UWorld* Context) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_UpgradeValue);
+	UGrapplingHookUpgradesSubsystem* UpgradesSubsystem = UGrapplingHookUpgradesSubsystem::Get(Context);
+	const uint32 Generation = UpgradesSubsystem ? UpgradesSubsystem->GetGeneration() : 0;
+	if (Generation != 0 && Generation == CachedGeneration)
+	{
+		UpgradesSubsystem->RecordHit();
+		return CachedValue;
+	}
+
+	const float ActiveValue = ResolveActiveValue(Context);
+	if (UpgradesSubsystem)
+	{
+		UpgradesSubsystem->RecordMiss();
+	}
+	if (Generation != 0)
+	{
+		CachedGeneration = Generation;
+		CachedValue = ActiveValue;
+	}
+	return ActiveValue;
+}
+
+float FGrapplingHookUpgradesChain::ResolveActiveValue(UWorld* Context) const
 {
 	float ActiveValue = BaseValue;
 	const AFGSchematicManager* SchematicManager = AFGSchematicManager::Get(Context);
@@ -157,8 +312,28 @@ float FGrapplingHookUpgradesChain::GetActiveValue(UWorld* Context) const
 	return ActiveValue;
 }
 
+static TAutoConsoleVariable<int32> CVarGrappleSwingRecordFrames(
+	TEXT("AsgGrapple.SwingRecordFrames"),
+	0,
+	TEXT("How many last tension ticks every grapple tool keeps for AsgGrapple.SaveSwings (0 - recording is disabled)."));
+
 AGrapplingHookTool::AGrapplingHookTool()
+	: AimQueryParams(SCENE_QUERY_STAT(GrappleAimTrace))
+	, CablePathQueryParams(SCENE_QUERY_STAT(GrappleCablePath))
 {
+	// Tick is enabled on demand by UpdateTickState
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	CrosshairTraceDelegate.BindUObject(this, &AGrapplingHookTool::OnCrosshairTraceCompleted);
+	TrajectoryTraceDelegate.BindUObject(this, &AGrapplingHookTool::OnTrajectoryTraceCompleted);
+}
+
+void AGrapplingHookTool::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	Hooks.SetNum(NumHooks);
 }
 
 void AGrapplingHookTool::Tick(const float DeltaSeconds)
@@ -175,94 +350,310 @@ void AGrapplingHookTool::Tick(const float DeltaSeconds)
 	}
 }
 
+void AGrapplingHookTool::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(GetWorld()))
+	{
+		Manager->UnregisterTool(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AGrapplingHookTool::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
-	DOREPLIFETIME(AGrapplingHookTool, GrappleProjectile);
-	DOREPLIFETIME(AGrapplingHookTool, DesiredCableLength);
-	DOREPLIFETIME(AGrapplingHookTool, bGrappleAttached);
+	DOREPLIFETIME(AGrapplingHookTool, Hooks);
+	// Velocity corrections only matter to the owner; other clients derive visual cable length from desired length
+	DOREPLIFETIME_CONDITION(AGrapplingHookTool, CableState, COND_OwnerOnly);
 }
 
-void AGrapplingHookTool::ServerTickGrapple_Implementation(const float DeltaSeconds)
+void AGrapplingHookTool::ServerTickGrapple(const float DeltaSeconds)
 {
-	if (!GrappleProjectile)
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_ServerTick);
+	CSV_SCOPED_TIMING_STAT(AsgGrapple, ServerTick);
+	// Attached hooks are simulated in batch by UGrapplingHookManagerSubsystem
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
 	{
-		return;
+		if (!Hooks[HookIndex].IsFlying())
+		{
+			continue;
+		}
+
+		// While hook is yet flying towards its target, return it if the shot exceeded maximum allowed cable length
+		const float ActualCurrentCableLength = GetDistanceToGrappleForcePoint(HookIndex);
+		if (ActualCurrentCableLength > GetMaxCableLength())
+		{
+			RetractHook(HookIndex);
+			continue;
+		}
+
+		// Update cable length until max length is reached (or projectile hits something)
+		ApplyCableLength(HookIndex, FMath::Max(0.1, FMath::Min(GetMaxCableLength(), ActualCurrentCableLength)));
 	}
 
-	// While grapple is yet flying towards its target
-	if (!bGrappleAttached)
+	// Otherwise cable state is sent after batched tension
+	if (!IsGrappleAttached())
 	{
-		// Return grapple if the shot exceeded maximum allowed cable length
-		const float ActualCurrentCableLength = GetDistanceToGrappleForcePoint();
-		if (ActualCurrentCableLength > GetMaxCableLength())
+		PendingCableState.ClearVelocity();
+		SendCableState();
+	}
+}
+
+int32 AGrapplingHookTool::GatherTensionBatchItems(TArray<FGrappleTensionBatchItem>& OutItems, const float DeltaSeconds)
+{
+	if (!IsGrappleAttached())
+	{
+		return 0;
+	}
+
+	// Velocity is only replicated when tension altered it this tick
+	PendingCableState.ClearVelocity();
+	UpdateCablePaths();
+	const int32 FirstItem = OutItems.Num();
+
+	// Hooks pulling instigator are solved together, so their tensions share one velocity
+	FGrappleTensionBatchItem& InstigatorItem = OutItems.AddDefaulted_GetRef();
+	if (MakeTensionInput(InstigatorItem.Input, InstigatorItem.HookIndices))
+	{
+		InitTensionBatchItem(InstigatorItem, DeltaSeconds, TensionTimeAccumulator);
+	}
+	else
+	{
+		OutItems.Pop(EAllowShrinking::No);
+	}
+
+	// Every pulled body is a separate item
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
+	{
+		if (GetPullMode(HookIndex) != EGrapplingHookPullMode::Object)
+		{
+			continue;
+		}
+		FGrappleTensionBatchItem& BodyItem = OutItems.AddDefaulted_GetRef();
+		if (!MakePullObjectTensionInput(HookIndex, BodyItem.Input))
+		{
+			OutItems.Pop(EAllowShrinking::No);
+			continue;
+		}
+		BodyItem.bPullsBody = true;
+		BodyItem.HookIndices.Add(HookIndex);
+		InitTensionBatchItem(BodyItem, DeltaSeconds, Hooks[HookIndex].TensionTimeAccumulator);
+	}
+	return OutItems.Num() - FirstItem;
+}
+
+void AGrapplingHookTool::ApplyTensionBatchItem(const FGrappleTensionBatchItem& Item, TArray<FGrapplePullImpulse>& OutPullImpulses)
+{
+	// An earlier item of this tool may have retracted some of the hooks already
+	for (const int32 HookIndex : Item.HookIndices)
+	{
+		if (!Hooks[HookIndex].IsAttached())
 		{
-			RetractGrapple();
 			return;
 		}
+	}
 
-		// Update cable length until max length is reached (or projectile hits something)
-		SetCableLength(FMath::Max(0.1, FMath::Min(GetMaxCableLength(), ActualCurrentCableLength))); 
+	// Recorded before tearing, so recordings show what broke the cable
+	if (!Item.bPullsBody)
+	{
+		RecordSwingFrame(Item, TensionTimeAccumulator);
 	}
 
-	if (bGrappleAttached)
+	// If player is over tearing distance of some hook (or thing it was hooked to is gone), retract that hook
+	if (Item.bTear)
+	{
+		RetractHook(Item.HookIndices[Item.TornConstraint]);
+		return;
+	}
+	for (const int32 HookIndex : Item.HookIndices)
 	{
-		// If player is over tearing distance, retract the grapple
-		if (const float DistanceOvershoot = GetDistanceToGrappleForcePoint() - DesiredCableLength;
-			DistanceOvershoot >= GetTearingDistance())
+		if (Hooks[HookIndex].Anchor.IsLost())
 		{
-			RetractGrapple();
+			RetractHook(HookIndex);
 			return;
 		}
-		
-		// Run physics simulation on server (has authority over client simulations, if any are running)
-		TickTensionForce(DeltaSeconds, true);
+	}
+
+	// Physics simulation on server has authority over client simulations, if any are running
+	if (Item.bPullsBody)
+	{
+		Hooks[Item.HookIndices[0]].TensionTimeAccumulator = Item.TimeAccumulator;
+		AddPullImpulse(Item, OutPullImpulses);
+	}
+	else
+	{
+		TensionTimeAccumulator = Item.TimeAccumulator;
+		ApplyTensionOutput(Item.Output, true);
+	}
+
+	// Keep visual cable length representing desired length
+	for (const int32 HookIndex : Item.HookIndices)
+	{
+		ApplyCableLength(HookIndex, GetAttachedVisualCableLength(HookIndex));
+	}
+
+	SendCableState();
+}
+
+void AGrapplingHookTool::SendCableState()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_SendCableState);
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (CableStateSendRate > 0 && Now - LastCableStateSendTime < 1.0f / CableStateSendRate)
+	{
+		return;
+	}
+	// Unchanged state would not be replicated anyway
+	if (PendingCableState.HasSameContents(CableState))
+	{
+		return;
+	}
+
+	LastCableStateSendTime = Now;
+	PendingCableState.SetSequence(static_cast<uint8>(CableState.GetSequence() + 1));
+	CableState = PendingCableState;
 
-		// Keep visual cable length representing desired length (resulting value is smaller so cable does not appear loose when it should be tense)  
-		SetCableLength(FMath::Max(50, DesiredCableLength - 250));
+	// Measure how much the state takes on the wire
+	CableStateSizeWriter.Reset();
+	bool bSuccess = true;
+	CableState.NetSerialize(CableStateSizeWriter, nullptr, bSuccess);
+	const int32 Bytes = CableStateSizeWriter.GetNumBytes();
+
+	CableStateNetStats.StatesSent++;
+	CSV_CUSTOM_STAT(AsgGrapple, CableStateBytes, Bytes, ECsvCustomStatOp::Accumulate);
+	if (UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(GetWorld()))
+	{
+		Manager->RecordCableStateUpdate(Bytes);
+	}
+	CableStateNetStats.BytesSent += Bytes;
+	CableStateNetStatsWindowBytes += Bytes;
+	if (const float WindowDuration = Now - CableStateNetStatsWindowStart;
+		WindowDuration >= 1.0f)
+	{
+		CableStateNetStats.BytesPerSecond = CableStateNetStatsWindowBytes / WindowDuration;
+		CableStateNetStatsWindowStart = Now;
+		CableStateNetStatsWindowBytes = 0;
 	}
 }
 
-void AGrapplingHookTool::SetCableLength_Implementation(const float NewLength)
+void AGrapplingHookTool::ApplyCableLength(const int32 HookIndex, const float NewLength)
 {
-	if (!GrappleProjectile || !GrappleProjectile->CableComponent)
+	const FGrappleHook& Hook = Hooks[HookIndex];
+	if (!Hook.Projectile || !Hook.Projectile->CableComponent)
 	{
 		return;
 	}
+	Hook.Projectile->SetRopeRestLength(GetRopeRestLength(HookIndex));
 
 	// Immediately after a shot, cable behaves erratically on clients.
 	// We bandaid this by having a straight cable instead of such broken visuals. 
-	if (GetNetMode() == NM_Client && !bGrappleAttached)
+	if (GetNetMode() == NM_Client && !Hook.bAttached)
 	{
-		GrappleProjectile->CableComponent->CableLength = 0;
+		Hook.Projectile->CableComponent->CableLength = 0;
 		return;
 	}
 
-	GrappleProjectile->CableComponent->CableLength = NewLength;
+	Hook.Projectile->CableComponent->CableLength = NewLength;
 }
 
 void AGrapplingHookTool::LoadFromItemState_Implementation(const FFGDynamicStruct& itemState)
 {
 	Super::LoadFromItemState_Implementation(itemState);
-	// TODO: maybe save/load projectile and its cable states?	
+
+	const FGrapplingHookItemState* LoadedState = itemState.GetValuePtr<FGrapplingHookItemState>();
+	if (!LoadedState || !LoadedState->IsRestorable())
+	{
+		return;
+	}
+	PendingItemState = *LoadedState;
+	RestorePendingItemState();
 }
 
 FFGDynamicStruct AGrapplingHookTool::SaveToItemState_Implementation() const
-{ 
-	// TODO: maybe save/load projectile and its cable states?
-	return Super::SaveToItemState_Implementation();
+{
+	if (!IsGrappleAttached())
+	{
+		return Super::SaveToItemState_Implementation();
+	}
 
+	FGrapplingHookItemState State;
+	State.Version = FGrapplingHookItemState::LatestVersion;
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
+	{
+		const FGrappleHook& Hook = Hooks[HookIndex];
+		if (!Hook.IsAttached())
+		{
+			continue;
+		}
+		FGrapplingHookSavedHook& SavedHook = State.Hooks.AddDefaulted_GetRef();
+		SavedHook.HookIndex = HookIndex;
+		SavedHook.AttachLocation = GetAnchorLocation(HookIndex);
+		SavedHook.AnchorActor = Hook.Anchor.GetOwnerActor();
+		SavedHook.DesiredCableLength = Hook.DesiredCableLength;
+		SavedHook.WrapPoints = Hook.CablePath.GetWrapPoints();
+	}
+	return FFGDynamicStruct(State);
 }
 
 bool AGrapplingHookTool::ShouldSave_Implementation() const
 {
-	// TODO: maybe save/load projectile and its cable states?
-	return false;
+	// Only attached hooks have anything worth saving
+	return IsGrappleAttached();
+}
+
+void AGrapplingHookTool::RestorePendingItemState()
+{
+	if (!PendingItemState.IsRestorable() || !HasAuthority() || !GetInstigatorCharacter() || HasGrappleProjectile())
+	{
+		return;
+	}
+	const FGrapplingHookItemState State = MoveTemp(PendingItemState);
+	PendingItemState = FGrapplingHookItemState();
+
+	UGrappleProjectilePoolSubsystem* ProjectilePool = UGrappleProjectilePoolSubsystem::Get(GetWorld());
+	if (!ProjectilePool)
+	{
+		return;
+	}
+	for (const FGrapplingHookSavedHook& SavedHook : State.Hooks)
+	{
+		// Tool may have fewer hooks than the one which was saved
+		if (!SavedHook.IsRestorable() || !Hooks.IsValidIndex(SavedHook.HookIndex) || Hooks[SavedHook.HookIndex].Projectile)
+		{
+			continue;
+		}
+		const int32 HookIndex = SavedHook.HookIndex;
+		FGrappleHook& Hook = Hooks[HookIndex];
+		Hook.Projectile = ProjectilePool->Acquire(GrappleProjectileClass, SavedHook.AttachLocation, FVector::ZeroVector);
+		if (!Hook.Projectile)
+		{
+			continue;
+		}
+		Hook.Projectile->SetInstigator(GetInstigator());
+		const AActor* AnchorActor = SavedHook.AnchorActor.Get();
+		Hook.Anchor.SetFromComponent(AnchorActor ? AnchorActor->GetRootComponent() : nullptr, SavedHook.AttachLocation);
+		OnHookProjectileChanged(HookIndex);
+
+		Hook.bAttached = true;
+		ResetHookSimulation(HookIndex);
+		Hook.CablePath.Restore(SavedHook.WrapPoints);
+		Hook.DesiredCableLength = FMath::Min(SavedHook.DesiredCableLength, GetMaxCableLength());
+		OnHookAttachedChanged(HookIndex);
+		OnHookDesiredCableLengthChanged(HookIndex);
+	}
+
+	if (UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(GetWorld());
+		Manager && IsGrappleAttached())
+	{
+		Manager->RegisterTool(this);
+	}
 }
 
 void AGrapplingHookTool::Equip(AFGCharacterPlayer* Character)
 {
 	Super::Equip(Character);
+	UpdateQueryParams();
 
 	AFGPlayerController* Controller = Character->GetFGPlayerController(); 
 	SetInputContextRegistered(Controller, true);
@@ -273,7 +664,12 @@ void AGrapplingHookTool::Equip(AFGCharacterPlayer* Character)
 		CrosshairHighlightWidget = CreateWidget(Controller, CrosshairHighlightWidgetClass);
 		CrosshairHighlightWidget->AddToPlayerScreen(10);
 		CrosshairHighlightWidget->SetVisibility(ESlateVisibility::Hidden);
+		bCrosshairHighlightVisible = false;
+		LastCrosshairTraceTime = -1;
 	}
+
+	RestorePendingItemState();
+	UpdateTickState();
 }
 
 void AGrapplingHookTool::UnEquip()
@@ -295,6 +691,7 @@ void AGrapplingHookTool::UnEquip()
 	}
 	
 	Super::UnEquip();
+	UpdateTickState();
 }
 
 void AGrapplingHookTool::AddEquipmentActionBindings()
@@ -308,8 +705,20 @@ void AGrapplingHookTool::AddEquipmentActionBindings()
 			if (AFGPlayerController* Controller = Player->GetFGPlayerController())
 			{
 				BIND_ACTION(Controller, PrimaryFireAction, Started, "HandleInput_PrimaryFire");
+				if (SecondaryFireAction)
+				{
+					BIND_ACTION(Controller, SecondaryFireAction, Started, "HandleInput_SecondaryFire");
+				}
 				BIND_ACTION(Controller, RetractCableAction, Triggered, "HandleInput_RetractCable");
 				BIND_ACTION(Controller, ExtendCableAction, Triggered, "HandleInput_ExtendCable");
+				if (RetractSecondaryCableAction)
+				{
+					BIND_ACTION(Controller, RetractSecondaryCableAction, Triggered, "HandleInput_RetractSecondaryCable");
+				}
+				if (ExtendSecondaryCableAction)
+				{
+					BIND_ACTION(Controller, ExtendSecondaryCableAction, Triggered, "HandleInput_ExtendSecondaryCable");
+				}
 				bInputsBound = true;
 			}
 		}
@@ -317,17 +726,28 @@ void AGrapplingHookTool::AddEquipmentActionBindings()
 }
 
 void AGrapplingHookTool::RetractGrapple()
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
+	{
+		if (Hooks[HookIndex].Projectile || !Hooks[HookIndex].bRetracted)
+		{
+			RetractHook(HookIndex);
+		}
+	}
+}
+
+void AGrapplingHookTool::RetractHook(const int32 HookIndex)
 {
 	if (AFGPlayerController* Controller = Cast<AFGPlayerController>(GetInstigatorController()))
 	{
 		if (UGrapplingHookRCO* RCO = Controller->GetRemoteCallObjectOfClass<UGrapplingHookRCO>())
 		{
-			RCO->ServerRetractGrapple(this);
-			if (!bRetracted)
+			RCO->ServerRetractGrapple(this, static_cast<uint8>(HookIndex));
+			if (FGrappleHook& Hook = Hooks[HookIndex];
+				!Hook.bRetracted)
 			{
-				bRetracted = true;
-				OnGrappleStartedRetracting();
-				OnGrappleFinishedRetracting();
+				Hook.bRetracted = true;
+				NotifyHookRetracted(HookIndex);
 			}
 		}
 	}
@@ -335,194 +755,547 @@ void AGrapplingHookTool::RetractGrapple()
 
 void AGrapplingHookTool::ClientTickGrapple(const float DeltaSeconds)
 {
-	if (bGrappleAttached)
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_ClientTick);
+	CSV_SCOPED_TIMING_STAT(AsgGrapple, ClientTick);
+	if (IsGrappleAttached())
 	{
 		// Apply length control queries to desired cable length 
-		if (!FMath::IsNearlyZero(DesiredCableLengthControlQuery))
+		TickCableLengthInput(DeltaSeconds);
+
+		// Cable length changes every frame as instigator moves, while ApplyCableLength only runs on replication
+		for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
 		{
-			if (AFGPlayerController* Controller = Cast<AFGPlayerController>(GetInstigatorController()))
+			if (const FGrappleHook& Hook = Hooks[HookIndex];
+				Hook.IsAttached() && Hook.Projectile->IsUsingRopeSolver())
 			{
-				if (UGrapplingHookRCO* RCO = Controller->GetRemoteCallObjectOfClass<UGrapplingHookRCO>())
-				{
-					// Length adjustment is processed on server first, and is replicated back to client afterwards
-					RCO->ServerProcessDesiredCableLengthQueries(this, DesiredCableLengthControlQuery, DeltaSeconds);
-					DesiredCableLengthControlQuery = 0;
-				}
+				Hook.Projectile->SetRopeRestLength(GetRopeRestLength(HookIndex));
 			}
 		}
+
+		if (IsPredictingTension())
+		{
+			TickPredictedTension(DeltaSeconds);
+		}
 	}
 
+	TickUnconfirmedShots();
+
 	// Update crosshair highlight widget visibility for local player
 	if (CrosshairHighlightWidget)
 	{
-		const AFGCharacterPlayer* Player = GetInstigatorCharacter();
-		const UWorld* World = GetWorld();
-		bool bShowCrosshairHighlight = false;
-		if (Player && World && GrappleProjectileClass && bRetracted)
-		{
-			FCollisionQueryParams QueryParams;
-			QueryParams.AddIgnoredActor(Player);
-			if (FHitResult HitResult;
-				World->LineTraceSingleByProfile(HitResult,
-					GetShootingSourceLocation(),
-					GetShootingSourceLocation() + Player->GetBaseAimRotation().Vector() * GetMaxCableLength(),
-					"Projectile", QueryParams))
-			{
-				bShowCrosshairHighlight = true;
-			}
-		}
-		CrosshairHighlightWidget->SetVisibility(bShowCrosshairHighlight ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Hidden);
+		TickCrosshairHighlight();
 	}		
 }
 
-void AGrapplingHookTool::SetInstigatorVelocity_Implementation(const FVector& NewVelocity)
+void AGrapplingHookTool::TickUnconfirmedShots()
 {
-	if (const AFGCharacterPlayer* Player = GetInstigatorCharacter())
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float Timeout = GetRoundTripTime() + ShotConfirmationTimeout;
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
 	{
-		if (UFGCharacterMovementComponent* Movement = Player->GetFGMovementComponent())
+		if (FGrappleHook& Hook = Hooks[HookIndex];
+			Hook.IsAwaitingShot() && Now - Hook.ClientShootTime > Timeout)
 		{
-			Movement->SetGeneralVelocity(NewVelocity);
+			Hook.bRetracted = true;
+			NotifyHookRetracted(HookIndex);
+			UpdateTickState();
 		}
 	}
 }
 
-void AGrapplingHookTool::HandleInput_PrimaryFire()
+void AGrapplingHookTool::TickCrosshairHighlight()
 {
-	if (AFGPlayerController* Controller = Cast<AFGPlayerController>(GetInstigatorController()))
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_CrosshairTrace);
+	const AFGCharacterPlayer* Player = GetInstigatorCharacter();
+	UWorld* World = GetWorld();
+	if (!Player || !World || !GrappleProjectileClass || !HasRetractedHook())
 	{
-		if (UGrapplingHookRCO* RCO = Controller->GetRemoteCallObjectOfClass<UGrapplingHookRCO>())
-		{
-			if (!GrappleProjectile) // shoot projectile if didn't yet
-			{
-				const AFGCharacterPlayer* Player = GetInstigatorCharacter();
-				if (!Player)
-				{
-					return;
-				}
+		SetCrosshairHighlightVisible(false);
+		LastCrosshairTraceTime = -1;
+		return;
+	}
 
-				bRetracted = false;
-				const FVector PlayerDirection = Player->GetBaseAimRotation().Vector();
-				RCO->ServerShootGrapple(this, GetShootingSourceLocation(), PlayerDirection);
-				OnGrappleFired();
-			}
-			else
-			{
-				RetractGrapple();
-			}
-		}
+	// Continue tracing predicted path started earlier
+	if (bPredictTrajectory)
+	{
+		TrajectoryPredictor.Tick(World, "Projectile", AimQueryParams, &TrajectoryTraceDelegate, TrajectorySegmentsPerTick);
 	}
-}
 
-void AGrapplingHookTool::HandleInput_RetractCable()
-{
-	if (!bGrappleAttached)
+	// Previous trace result is yet to arrive
+	if (bCrosshairTracePending)
 	{
 		return;
 	}
 
-	DesiredCableLengthControlQuery -= GetCableLengthControlStep();
-}
+	const float Now = World->GetTimeSeconds();
+	const bool bHasPreviousTrace = LastCrosshairTraceTime >= 0;
+	if (bHasPreviousTrace && Now - LastCrosshairTraceTime < 1.0f / CrosshairUpdateRate)
+	{
+		return;
+	}
+	// Restarting unfinished path would throw its traces away, and while aim keeps moving no path would ever complete
+	if (bPredictTrajectory && TrajectoryPredictor.IsStarted() && !TrajectoryPredictor.IsComplete()
+		&& Now - LastCrosshairTraceTime < CrosshairMaxStaleness)
+	{
+		return;
+	}
 
-void AGrapplingHookTool::HandleInput_ExtendCable()
-{
-	if (!bGrappleAttached)
+	const FVector Source = GetShootingSourceLocation();
+	const FVector Direction = Player->GetBaseAimRotation().Vector();
+	if (bHasPreviousTrace && Now - LastCrosshairTraceTime < CrosshairMaxStaleness
+		&& FVector::DotProduct(Direction, LastCrosshairTraceDirection) >= FMath::Cos(FMath::DegreesToRadians(CrosshairAimAngleThreshold))
+		&& FVector::DistSquared(Source, LastCrosshairTraceSource) < FMath::Square(CrosshairSourceMoveThreshold))
 	{
 		return;
 	}
 
-	DesiredCableLengthControlQuery += GetCableLengthControlStep();
-}
+	LastCrosshairTraceTime = Now;
+	LastCrosshairTraceSource = Source;
+	LastCrosshairTraceDirection = Direction;
 
-void AGrapplingHookTool::TickTensionForce(const float DeltaSeconds, const bool bPropagateOverNetwork)
+	// Highlight keeps showing previous result until new path is complete
+	if (bPredictTrajectory)
+	{
+		TrajectoryPredictor.Start(MakeTrajectoryParams(Source, Direction));
+		TrajectoryPredictor.Tick(World, "Projectile", AimQueryParams, &TrajectoryTraceDelegate, TrajectorySegmentsPerTick);
+		return;
+	}
+
+	bCrosshairTracePending = true;
+
+	World->AsyncLineTraceByProfile(EAsyncTraceType::Single, Source, Source + Direction * GetMaxCableLength(),
+		"Projectile", AimQueryParams, &CrosshairTraceDelegate);
+}
+
+void AGrapplingHookTool::OnCrosshairTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_CrosshairTrace);
+	bCrosshairTracePending = false;
+
+	// Grapple may have been shot while trace was in flight
+	const bool bHit = TraceDatum.OutHits.Num() > 0 && TraceDatum.OutHits[0].bBlockingHit;
+	SetCrosshairHighlightVisible(bHit && HasRetractedHook());
+}
+
+void AGrapplingHookTool::OnTrajectoryTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
 {
-	const float ActualCurrentCableLength = GetDistanceToGrappleForcePoint();
-	if (ActualCurrentCableLength >= DesiredCableLength)
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_CrosshairTrace);
+	if (!TrajectoryPredictor.OnSegmentTraceCompleted(TraceDatum))
 	{
-		if (const AFGCharacterPlayer* ToolOwner = GetInstigatorCharacter())
+		return;
+	}
+
+	SetCrosshairHighlightVisible(TrajectoryPredictor.IsReachable() && HasRetractedHook());
+	OnTrajectoryPredicted(TrajectoryPredictor.IsReachable());
+}
+
+FGrappleTrajectoryParams AGrapplingHookTool::MakeTrajectoryParams(const FVector& Source, const FVector& Direction) const
+{
+	FGrappleTrajectoryParams Params;
+	Params.Origin = Source;
+	// Server spawns projectile a bit in front of the source (or where that is blocked, which is not worth a trace here)
+	Params.Start = Source + Direction * 150;
+	Params.MaxDistance = GetMaxCableLength();
+	Params.TimeStep = TrajectoryTimeStep;
+	Params.MaxTime = TrajectoryMaxTime;
+
+	const AFGCharacterPlayer* Player = GetInstigatorCharacter();
+	const FVector PlayerVelocity = Player ? Player->GetVelocity() : FVector::ZeroVector;
+	Params.Velocity = Direction * GetInitialHookVelocity() + PlayerVelocity.ProjectOnToNormal(Direction);
+
+	const AGrappleProjectile* ProjectileDefaults = GrappleProjectileClass ? GrappleProjectileClass->GetDefaultObject<AGrappleProjectile>() : nullptr;
+	if (const UProjectileMovementComponent* ProjectileMovement = ProjectileDefaults ? ProjectileDefaults->FindComponentByClass<UProjectileMovementComponent>() : nullptr)
+	{
+		Params.GravityZ = ProjectileMovement->ShouldApplyGravity() ? GetWorld()->GetGravityZ() * ProjectileMovement->ProjectileGravityScale : 0;
+		if (ProjectileMovement->MaxSpeed > 0)
 		{
-			if (UFGCharacterMovementComponent* Movement = ToolOwner->GetFGMovementComponent())
-			{
-				// Tension force is player's inverse velocity projected onto grapple direction vector
-				const FVector TensionForceDirection = (GetGrappleForcePoint() - ToolOwner->GetActorLocation()).GetSafeNormal();
-				const FVector TensionForce = (-Movement->GetVelocity()).ProjectOnTo(TensionForceDirection);
+			Params.Velocity = Params.Velocity.GetClampedToMaxSize(ProjectileMovement->MaxSpeed);
+		}
+	}
+	else
+	{
+		Params.GravityZ = GetWorld()->GetGravityZ();
+	}
+	return Params;
+}
 
-				FVector DesiredVelocity = Movement->Velocity;
+void AGrapplingHookTool::SetCrosshairHighlightVisible(const bool bVisible)
+{
+	if (!CrosshairHighlightWidget || bCrosshairHighlightVisible == bVisible)
+	{
+		return;
+	}
+	bCrosshairHighlightVisible = bVisible;
+	CrosshairHighlightWidget->SetVisibility(bVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Hidden);
+}
 
-				// Apply tension force, if its direction is facing grapple point
-				if (FMath::IsNearlyEqual(FVector::DotProduct(TensionForceDirection, TensionForce.GetSafeNormal()), 1.0f, 1e-06))
-				{
-					// In air, we make the rope feel stretchable by applying the force over time instead of instantly
-					// On the ground however it's a different story, because player has friction, tfw much more resistance to external forces - we apply full force immediately.
-					const float TimeMultiplier = Movement->MovementMode == MOVE_Walking ? 1 : DeltaSeconds*3;
-					DesiredVelocity += TensionForce * TimeMultiplier;  
-				}
+void AGrapplingHookTool::ApplyInstigatorVelocity(const FVector& NewVelocity)
+{
+	if (const AFGCharacterPlayer* Player = GetInstigatorCharacter())
+	{
+		if (UFGCharacterMovementComponent* Movement = Player->GetFGMovementComponent())
+		{
+			Movement->SetGeneralVelocity(NewVelocity);
+		}
+	}
+}
 
-				// If cable is longer than desired length allows, tension should pull player towards grapple point
-				if (ActualCurrentCableLength > DesiredCableLength)
-				{
-					const float ExcessDistance = ActualCurrentCableLength - DesiredCableLength;
-					DesiredVelocity += TensionForceDirection * ExcessDistance * DeltaSeconds * 10;
-				}
+void AGrapplingHookTool::HandleInput_PrimaryFire()
+{
+	HandleFireInput(0);
+}
 
-				// Apply velocity to movement comp
-				Movement->Velocity = DesiredVelocity;
+void AGrapplingHookTool::HandleInput_SecondaryFire()
+{
+	if (Hooks.IsValidIndex(1))
+	{
+		HandleFireInput(1);
+	}
+}
 
-				// Help player to automatically take off the ground if floor normal to tension force angle is less than ~43 degrees 
-				if (Movement->MovementMode == MOVE_Walking)
+void AGrapplingHookTool::HandleFireInput(const int32 HookIndex)
+{
+	if (AFGPlayerController* Controller = Cast<AFGPlayerController>(GetInstigatorController()))
+	{
+		if (UGrapplingHookRCO* RCO = Controller->GetRemoteCallObjectOfClass<UGrapplingHookRCO>())
+		{
+			if (!Hooks[HookIndex].Projectile) // shoot projectile if didn't yet
+			{
+				const AFGCharacterPlayer* Player = GetInstigatorCharacter();
+				if (!Player)
 				{
-					const float Dot = FMath::Clamp(FVector::DotProduct(Movement->CurrentFloor.HitResult.Normal, TensionForceDirection), -1.0f, 1.0f);
-					const float FloorNormalToTensionDirAngle = FMath::Acos(Dot); 
-					if (FloorNormalToTensionDirAngle < (PI/4 - PI/64))
-					{
-						Movement->MovementMode = MOVE_Falling;
-						Movement->CurrentFloor.Clear();
-					}
+					return;
 				}
-
-				if (bPropagateOverNetwork)
+				// Server would drop the shot anyway
+				FGrappleHook& Hook = Hooks[HookIndex];
+				const float Now = GetWorld()->GetTimeSeconds();
+				if (LastClientShootTime >= 0 && Now - LastClientShootTime < UAsgGrapplingHookSettings::Get()->ShootMinInterval)
 				{
-					// Manually propagate velocity changes over network to reduce movement lag on clients
-					SetInstigatorVelocity(Movement->Velocity);
+					return;
 				}
+
+				Hook.bRetracted = false;
+				Hook.ClientShootTime = Now;
+				LastClientShootTime = Now;
+				const FVector PlayerDirection = Player->GetBaseAimRotation().Vector();
+				RCO->ServerShootGrapple(this, static_cast<uint8>(HookIndex), GetShootingSourceLocation(), PlayerDirection);
+				NotifyHookFired(HookIndex);
+				UpdateTickState();
+			}
+			else
+			{
+				RetractHook(HookIndex);
 			}
 		}
 	}
 }
 
-void AGrapplingHookTool::OnGrappleHitSurface(const FHitResult& HitResult)
+void AGrapplingHookTool::HandleInput_RetractCable()
+{
+	AddCableLengthControlQuery(0, -GetCableLengthControlStep());
+}
+
+void AGrapplingHookTool::HandleInput_ExtendCable()
+{
+	AddCableLengthControlQuery(0, GetCableLengthControlStep());
+}
+
+void AGrapplingHookTool::HandleInput_RetractSecondaryCable()
+{
+	AddCableLengthControlQuery(1, -GetCableLengthControlStep());
+}
+
+void AGrapplingHookTool::HandleInput_ExtendSecondaryCable()
+{
+	AddCableLengthControlQuery(1, GetCableLengthControlStep());
+}
+
+void AGrapplingHookTool::AddCableLengthControlQuery(const int32 HookIndex, const float Query)
+{
+	const bool bSteersEveryHook = HookIndex == 0 && !RetractSecondaryCableAction && !ExtendSecondaryCableAction;
+	for (int32 Index = 0; Index < Hooks.Num(); Index++)
+	{
+		if ((Index == HookIndex || bSteersEveryHook) && Hooks[Index].IsAttached())
+		{
+			Hooks[Index].CableLengthControlQuery += Query;
+		}
+	}
+}
+
+void AGrapplingHookTool::TickTensionForce(const float DeltaSeconds, const bool bPropagateOverNetwork)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_TensionForce);
+	FGrappleTensionBatchItem Item;
+	if (!MakeTensionInput(Item.Input, Item.HookIndices))
+	{
+		return;
+	}
+
+	const float TimeAccumulatorBefore = TensionTimeAccumulator;
+	const FGrappleTensionOutput Output = bUseFixedTimestepTension
+		? FGrappleTensionSolver::Integrate(Item.Input, DeltaSeconds, TensionFixedTimestep, MaxTensionSubsteps, TensionTimeAccumulator)
+		: FGrappleTensionSolver::Step(Item.Input, DeltaSeconds);
+
+	if (CVarGrappleSwingRecordFrames.GetValueOnGameThread() > 0)
+	{
+		// Tearing is only checked by server, so it never happens in recordings of this path
+		InitTensionBatchItem(Item, DeltaSeconds, TensionTimeAccumulator);
+		Item.TearingDistance = TNumericLimits<float>::Max();
+		Item.Output = Output;
+		RecordSwingFrame(Item, TimeAccumulatorBefore);
+	}
+
+	ApplyTensionOutput(Output, bPropagateOverNetwork);
+}
+
+void AGrapplingHookTool::RecordSwingFrame(const FGrappleTensionBatchItem& Item, const float TimeAccumulatorBefore)
+{
+	const int32 Capacity = CVarGrappleSwingRecordFrames.GetValueOnGameThread();
+	if (Capacity <= 0)
+	{
+		return;
+	}
+	if (SwingRecorder.GetCapacity() != Capacity)
+	{
+		SwingRecorder.Initialize(Capacity);
+	}
+
+	FGrappleSwingFrame Frame;
+	Frame.Item = Item;
+	Frame.TimeAccumulatorBefore = TimeAccumulatorBefore;
+	if (const AFGCharacterPlayer* ToolOwner = GetInstigatorCharacter())
+	{
+		if (const UFGCharacterMovementComponent* Movement = ToolOwner->GetFGMovementComponent())
+		{
+			Frame.MovementMode = Movement->MovementMode;
+		}
+	}
+	SwingRecorder.Record(Frame);
+}
+
+bool AGrapplingHookTool::MakeTensionInput(FGrappleTensionInput& OutInput, TArray<int32, TInlineAllocator<2>>& OutHookIndices) const
+{
+	const AFGCharacterPlayer* ToolOwner = GetInstigatorCharacter();
+	const UFGCharacterMovementComponent* Movement = ToolOwner ? ToolOwner->GetFGMovementComponent() : nullptr;
+	if (!Movement)
+	{
+		return false;
+	}
+
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
+	{
+		if (!Hooks[HookIndex].IsAttached() || GetPullMode(HookIndex) != EGrapplingHookPullMode::Self)
+		{
+			continue;
+		}
+		FGrappleTensionConstraint& Constraint = OutInput.Constraints.AddDefaulted_GetRef();
+		Constraint.ForcePoint = GetHookForcePoint(HookIndex);
+		Constraint.CableLength = GetDistanceToGrappleForcePoint(HookIndex);
+		Constraint.DesiredCableLength = Hooks[HookIndex].DesiredCableLength;
+		OutHookIndices.Add(HookIndex);
+	}
+	if (OutInput.Constraints.IsEmpty())
+	{
+		return false;
+	}
+
+	OutInput.Velocity = Movement->Velocity;
+	OutInput.CharacterLocation = ToolOwner->GetActorLocation();
+	OutInput.bWalking = Movement->MovementMode == MOVE_Walking;
+	OutInput.FloorNormal = Movement->CurrentFloor.HitResult.Normal;
+	return true;
+}
+
+bool AGrapplingHookTool::MakePullObjectTensionInput(const int32 HookIndex, FGrappleTensionInput& OutInput) const
+{
+	const AFGCharacterPlayer* ToolOwner = GetInstigatorCharacter();
+	const UFGCharacterMovementComponent* Movement = ToolOwner ? ToolOwner->GetFGMovementComponent() : nullptr;
+	const FGrappleHook& Hook = Hooks[HookIndex];
+	const FBodyInstance* Body = Hook.Anchor.GetBodyInstance();
+	if (!Movement || !Body || !Body->IsInstanceSimulatingPhysics())
+	{
+		return false;
+	}
+
+	// Solver sees the body as the grappled character and the instigator as the grapple point. Velocity is relative
+	// to the instigator, so the body is reeled in the same way whether instigator stands or runs.
+	const FVector AnchorLocation = GetAnchorLocation(HookIndex);
+	OutInput.Velocity = Body->GetUnrealWorldVelocityAtPoint(AnchorLocation) - Movement->Velocity;
+	OutInput.CharacterLocation = AnchorLocation;
+	FGrappleTensionConstraint& Constraint = OutInput.Constraints.AddDefaulted_GetRef();
+	Constraint.ForcePoint = Hook.CablePath.GetAnchorPullPoint(GetShootingSourceLocation());
+	Constraint.CableLength = GetDistanceToGrappleForcePoint(HookIndex);
+	Constraint.DesiredCableLength = Hook.DesiredCableLength;
+	// Ground friction of bodies is up to physics
+	OutInput.bWalking = false;
+	return true;
+}
+
+void AGrapplingHookTool::InitTensionBatchItem(FGrappleTensionBatchItem& Item, const float DeltaSeconds, const float TimeAccumulator) const
+{
+	Item.DeltaSeconds = DeltaSeconds;
+	Item.TearingDistance = GetTearingDistance();
+	Item.bFixedTimestep = bUseFixedTimestepTension;
+	Item.FixedTimestep = TensionFixedTimestep;
+	Item.MaxSubsteps = MaxTensionSubsteps;
+	Item.TimeAccumulator = TimeAccumulator;
+}
+
+void AGrapplingHookTool::AddPullImpulse(const FGrappleTensionBatchItem& Item, TArray<FGrapplePullImpulse>& OutPullImpulses) const
 {
-	bGrappleAttached = true;
-	DesiredCableLength = GetDistanceToGrappleForcePoint();
-	OnRep_GrappleAttached();
-	OnRep_DesiredCableLength();
+	// Slack cable doesn't touch the body, so resting bodies are left asleep
+	FBodyInstance* Body = Hooks[Item.HookIndices[0]].Anchor.GetBodyInstance();
+	if (!Item.Output.bTense || !Body || !Body->IsInstanceSimulatingPhysics())
+	{
+		return;
+	}
+
+	const FVector Impulse = (Item.Output.Velocity - Item.Input.Velocity) * Body->GetBodyMass();
+	FGrapplePullImpulse& Pull = OutPullImpulses.AddDefaulted_GetRef();
+	Pull.Body = Body;
+	Pull.Impulse = Impulse.GetClampedToMaxSize(GetMaxPullForce() * Item.DeltaSeconds);
+	Pull.Location = Item.Input.CharacterLocation;
 }
 
-float AGrapplingHookTool::GetDistanceToGrappleForcePoint() const
+void AGrapplingHookTool::ApplyTensionOutput(const FGrappleTensionOutput& Output, const bool bPropagateOverNetwork)
 {
+	if (!Output.bTense)
+	{
+		return;
+	}
 	const AFGCharacterPlayer* ToolOwner = GetInstigatorCharacter();
-	if (!GrappleProjectile || !ToolOwner)
+	UFGCharacterMovementComponent* Movement = ToolOwner ? ToolOwner->GetFGMovementComponent() : nullptr;
+	if (!Movement)
+	{
+		return;
+	}
+
+	// Apply velocity to movement comp
+	Movement->Velocity = Output.Velocity;
+
+	if (Output.bTakeOff)
+	{
+		Movement->MovementMode = MOVE_Falling;
+		Movement->CurrentFloor.Clear();
+	}
+
+	if (bPropagateOverNetwork)
+	{
+		// Manually propagate velocity changes over network to reduce movement lag on clients
+		PendingCableState.SetVelocity(Movement->Velocity);
+	}
+}
+
+void AGrapplingHookTool::BindImpactEvent(AGrappleProjectile::FGrappleProjectileImpactDelegate& ImpactEvent, AGrapplingHookTool* Tool)
+{
+	if (!ImpactEvent.IsBoundToObject(Tool))
+	{
+		ImpactEvent.BindUObject(Tool, &AGrapplingHookTool::OnGrappleHitSurface);
+	}
+}
+
+void AGrapplingHookTool::OnGrappleHitSurface(AGrappleProjectile* Projectile, const FHitResult& HitResult)
+{
+	// Binding outlives the shot, so projectile may have been released and taken by another hook meanwhile
+	const int32 HookIndex = Hooks.IndexOfByPredicate([Projectile](const FGrappleHook& Hook) { return Hook.Projectile == Projectile; });
+	if (HookIndex == INDEX_NONE || Hooks[HookIndex].bAttached)
+	{
+		return;
+	}
+	FGrappleHook& Hook = Hooks[HookIndex];
+	Hook.Anchor.SetFromHit(HitResult);
+	OnHookAnchorChanged(HookIndex);
+	Hook.bAttached = true;
+	ResetHookSimulation(HookIndex);
+	Hook.DesiredCableLength = GetDistanceToGrappleForcePoint(HookIndex);
+	OnHookAttachedChanged(HookIndex);
+	OnHookDesiredCableLengthChanged(HookIndex);
+
+	if (UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(GetWorld()))
+	{
+		Manager->RegisterTool(this);
+	}
+}
+
+float AGrapplingHookTool::GetDistanceToGrappleForcePoint(const int32 HookIndex) const
+{
+	const AFGCharacterPlayer* ToolOwner = GetInstigatorCharacter();
+	if (!Hooks[HookIndex].Projectile || !ToolOwner)
 	{
 		return 0;
 	}
 
-	// TODO: Implement support for cable turns 
-	return FVector::Distance(GetShootingSourceLocation(), GetGrappleForcePoint());
+	return Hooks[HookIndex].CablePath.GetLength(GetShootingSourceLocation(), GetAnchorLocation(HookIndex));
+}
+
+float AGrapplingHookTool::GetRopeRestLength(const int32 HookIndex) const
+{
+	// Slack cable is as long as desired length, tense one as long as the path to the hook
+	const float ActualLength = GetDistanceToGrappleForcePoint(HookIndex);
+	return Hooks[HookIndex].bAttached ? FMath::Max(ActualLength, Hooks[HookIndex].DesiredCableLength) : ActualLength;
 }
 
-FVector AGrapplingHookTool::GetGrappleForcePoint() const
+FVector AGrapplingHookTool::GetHookForcePoint(const int32 HookIndex) const
 {
-	if (!GrappleProjectile)
+	if (!Hooks.IsValidIndex(HookIndex) || !Hooks[HookIndex].Projectile)
 	{
 		return RootComponent->GetComponentLocation();
 	}
 
-	// TODO: Implement support for cable turns
-	return GrappleProjectile->GetActorLocation();
+	return Hooks[HookIndex].CablePath.GetForcePoint(GetAnchorLocation(HookIndex));
+}
+
+void AGrapplingHookTool::UpdateCablePaths()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_CablePathTrace);
+	const AFGCharacterPlayer* ToolOwner = GetInstigatorCharacter();
+	if (!ToolOwner)
+	{
+		return;
+	}
+
+	const FVector SourceLocation = GetShootingSourceLocation();
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
+	{
+		if (Hooks[HookIndex].Projectile)
+		{
+			Hooks[HookIndex].CablePath.Update(GetWorld(), SourceLocation, GetAnchorLocation(HookIndex), CablePathQueryParams, CableWrapSettings);
+		}
+	}
+}
+
+FVector AGrapplingHookTool::GetAnchorLocation(const int32 HookIndex) const
+{
+	const FGrappleHook& Hook = Hooks[HookIndex];
+	if (Hook.bAttached && Hook.Anchor.IsSet())
+	{
+		return Hook.Anchor.GetWorldLocation();
+	}
+	return Hook.Projectile->GetActorLocation();
+}
+
+void AGrapplingHookTool::UpdateQueryParams()
+{
+	// Clearing keeps ignore lists' storage, so refreshing never allocates once params were filled
+	AimQueryParams.ClearIgnoredActors();
+	CablePathQueryParams.ClearIgnoredActors();
+	if (const AFGCharacterPlayer* Player = GetInstigatorCharacter())
+	{
+		AimQueryParams.AddIgnoredActor(Player);
+		CablePathQueryParams.AddIgnoredActor(Player);
+	}
+	for (const FGrappleHook& Hook : Hooks)
+	{
+		if (Hook.Projectile)
+		{
+			CablePathQueryParams.AddIgnoredActor(Hook.Projectile);
+		}
+	}
 }
 
 float AGrapplingHookTool::GetDesiredCableLengthQueries() const
 {
-	return DesiredCableLengthControlQuery;
+	return Hooks.IsValidIndex(0) ? Hooks[0].CableLengthControlQuery : 0;
 }
 
 float AGrapplingHookTool::GetCableLengthControlStep() const
@@ -545,11 +1318,160 @@ float AGrapplingHookTool::GetInitialHookVelocity() const
 	return UpgradesPower.GetActiveValue(this);
 }
 
+float AGrapplingHookTool::GetMaxPullForce() const
+{
+	return GetInitialHookVelocity() * PullForcePerPower;
+}
+
+EGrapplingHookPullMode AGrapplingHookTool::GetPullMode(const int32 HookIndex) const
+{
+	return bPullSimulatingObjects && Hooks.IsValidIndex(HookIndex) && Hooks[HookIndex].IsAttached() && Hooks[HookIndex].Anchor.IsSimulatingPhysics()
+		? EGrapplingHookPullMode::Object
+		: EGrapplingHookPullMode::Self;
+}
+
+bool AGrapplingHookTool::HasGrappleProjectile() const
+{
+	return Hooks.ContainsByPredicate([](const FGrappleHook& Hook) { return Hook.Projectile != nullptr; });
+}
+
+bool AGrapplingHookTool::IsGrappleAttached() const
+{
+	return Hooks.ContainsByPredicate([](const FGrappleHook& Hook) { return Hook.IsAttached(); });
+}
+
+bool AGrapplingHookTool::IsPullingInstigator() const
+{
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
+	{
+		if (Hooks[HookIndex].IsAttached() && GetPullMode(HookIndex) == EGrapplingHookPullMode::Self)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void AGrapplingHookTool::NotifyHookFired(const int32 HookIndex)
+{
+	OnHookFired(HookIndex);
+	if (HookIndex == 0)
+	{
+		OnGrappleFired();
+	}
+}
+
+void AGrapplingHookTool::NotifyHookAttached(const int32 HookIndex)
+{
+	OnHookAttached(HookIndex);
+	if (HookIndex == 0)
+	{
+		OnGrappleAttached();
+	}
+}
+
+void AGrapplingHookTool::NotifyHookRetracted(const int32 HookIndex)
+{
+	OnHookStartedRetracting(HookIndex);
+	OnHookFinishedRetracting(HookIndex);
+	if (HookIndex == 0)
+	{
+		OnGrappleStartedRetracting();
+		OnGrappleFinishedRetracting();
+	}
+}
+
+void AGrapplingHookTool::NotifyHookCableLengthChanged(const int32 HookIndex, const float NewRatio)
+{
+	OnHookDesiredCableLengthRatioChanged(HookIndex, NewRatio);
+	if (HookIndex == 0)
+	{
+		OnDesiredCableLengthChanged(NewRatio);
+	}
+}
+
+bool AGrapplingHookTool::HasRetractedHook() const
+{
+	return Hooks.ContainsByPredicate([](const FGrappleHook& Hook) { return Hook.bRetracted; });
+}
+
+float AGrapplingHookTool::GetRoundTripTime() const
+{
+	const AController* Controller = GetInstigatorController();
+	return Controller && Controller->PlayerState ? Controller->PlayerState->GetPingInMilliseconds() / 1000.0f : 0;
+}
+
 USceneComponent* AGrapplingHookTool::GetCableAttachComponent_Implementation() const
 {
 	return RootComponent;
 }
 
+void AGrapplingHookTool::TickCableLengthInput(const float DeltaSeconds)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float SendInterval = 1.0f / FMath::Max(1.0f, CableLengthInputSendRate);
+
+	// Every hook is steered by its own length input
+	bool bAnyDirty = false;
+	bool bAnyPending = false;
+	for (FGrappleHook& Hook : Hooks)
+	{
+		const float Query = Hook.CableLengthControlQuery;
+		Hook.CableLengthControlQuery = 0;
+		if (!Hook.IsAttached())
+		{
+			continue;
+		}
+		if (!FMath::IsNearlyZero(Query))
+		{
+			// Continue from our own target while server may not have replicated it back yet, otherwise start from server value
+			if (!Hook.bCableLengthInputDirty && Hook.CableLengthInputResends == 0 && Now - LastCableLengthInputSendTime > SendInterval * 4)
+			{
+				Hook.ClientTargetCableLength = Hook.DesiredCableLength;
+			}
+			Hook.ClientTargetCableLength = FMath::Clamp(Hook.ClientTargetCableLength + Query * DeltaSeconds, 0.0f, GetMaxCableLength());
+			Hook.bCableLengthInputDirty = true;
+		}
+		bAnyDirty |= Hook.bCableLengthInputDirty;
+		bAnyPending |= Hook.bCableLengthInputDirty || Hook.CableLengthInputResends > 0;
+	}
+
+	if (!bAnyPending)
+	{
+		return;
+	}
+	if (Now - LastCableLengthInputSendTime < SendInterval)
+	{
+		if (bAnyDirty)
+		{
+			CableLengthInputStats.RpcsSuppressed++;
+		}
+		return;
+	}
+
+	AFGPlayerController* Controller = Cast<AFGPlayerController>(GetInstigatorController());
+	UGrapplingHookRCO* RCO = Controller ? Controller->GetRemoteCallObjectOfClass<UGrapplingHookRCO>() : nullptr;
+	if (!RCO)
+	{
+		return;
+	}
+
+	// Length adjustment is processed on server first, and is replicated back to client afterwards
+	LastCableLengthInputSendTime = Now;
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
+	{
+		FGrappleHook& Hook = Hooks[HookIndex];
+		if (!Hook.IsAttached() || (!Hook.bCableLengthInputDirty && Hook.CableLengthInputResends == 0))
+		{
+			continue;
+		}
+		Hook.CableLengthInputResends = Hook.bCableLengthInputDirty ? 1 : Hook.CableLengthInputResends - 1;
+		Hook.bCableLengthInputDirty = false;
+		RCO->ServerSetDesiredCableLength(this, static_cast<uint8>(HookIndex), ++Hook.CableLengthInputSequence, Hook.ClientTargetCableLength);
+		CableLengthInputStats.RpcsSent++;
+	}
+}
+
 // ReSharper disable once CppMemberFunctionMayBeConst
 void AGrapplingHookTool::SetInputContextRegistered(AFGPlayerController* Controller, const bool bRegistered)
 {
@@ -560,41 +1482,252 @@ void AGrapplingHookTool::SetInputContextRegistered(AFGPlayerController* Controll
 	Controller->SetMappingContextBoundWithHandle(GrappleInputContextHandle, GrappleInputContext, bRegistered);
 }
 
-void AGrapplingHookTool::OnRep_GrappleProjectile()
+void AGrapplingHookTool::OnRep_Hooks(const TArray<FGrappleHook>& PreviousHooks)
 {
-	if (GrappleProjectile)
+	// Hooks replicate as one array, so find out what changed in every one of them
+	static const FGrappleHook EmptyHook;
+	for (int32 HookIndex = 0; HookIndex < Hooks.Num(); HookIndex++)
 	{
-		GrappleProjectile->CableComponent->CableGravityScale = bGrappleAttached ? CableGravityScaleAfterHit : CableGravityScaleBeforeHit;
-		GrappleProjectile->CableComponent->SetAttachEndToComponent(GetCableAttachComponent(), CableAttachComponentSocket);
+		const FGrappleHook& Previous = PreviousHooks.IsValidIndex(HookIndex) ? PreviousHooks[HookIndex] : EmptyHook;
+		const FGrappleHook& Hook = Hooks[HookIndex];
+		if (Previous.Projectile != Hook.Projectile || Previous.bAttached != Hook.bAttached)
+		{
+			// Owning client predicts with the same cable path and history, which belong to the previous attachment now
+			ResetHookSimulation(HookIndex);
+		}
+		if (Previous.Projectile != Hook.Projectile)
+		{
+			OnHookProjectileChanged(HookIndex);
+		}
+		else if (!(Previous.Anchor == Hook.Anchor))
+		{
+			OnHookAnchorChanged(HookIndex);
+		}
+		if (Previous.bAttached != Hook.bAttached)
+		{
+			OnHookAttachedChanged(HookIndex);
+		}
+		if (Previous.DesiredCableLength != Hook.DesiredCableLength)
+		{
+			OnHookDesiredCableLengthChanged(HookIndex);
+		}
+	}
+}
+
+void AGrapplingHookTool::ResetHookSimulation(const int32 HookIndex)
+{
+	FGrappleHook& Hook = Hooks[HookIndex];
+	Hook.CablePath.Reset();
+	Hook.TensionTimeAccumulator = 0;
+
+	// Instigator's simulation starts over when its first hook attaches or the last one detaches
+	const int32 NumAttached = Algo::CountIf(Hooks, [](const FGrappleHook& Other) { return Other.IsAttached(); });
+	if (NumAttached == 0 || (NumAttached == 1 && Hook.IsAttached()))
+	{
+		TensionTimeAccumulator = 0;
+		PredictionHistory.Reset();
+		PendingPredictionCorrection = FVector::ZeroVector;
+	}
+}
+
+void AGrapplingHookTool::OnHookAnchorChanged(const int32 HookIndex)
+{
+	// Anchor and projectile may change independently, so this is also called when projectile changes
+	FGrappleHook& Hook = Hooks[HookIndex];
+	if (AGrappleProjectile* Settled = Hook.SettledProjectile.Get();
+		Settled && (Settled != Hook.Projectile || !Hook.Anchor.IsSet()))
+	{
+		Settled->ReleaseAnchor();
+		Hook.SettledProjectile = nullptr;
+	}
+	if (Hook.Projectile && Hook.Anchor.IsSet())
+	{
+		Hook.Projectile->SettleAtAnchor(Hook.Anchor);
+		Hook.SettledProjectile = Hook.Projectile;
+	}
+}
+
+void AGrapplingHookTool::OnHookProjectileChanged(const int32 HookIndex)
+{
+	UpdateQueryParams();
+	OnHookAnchorChanged(HookIndex);
+	FGrappleHook& Hook = Hooks[HookIndex];
+	if (Hook.Projectile)
+	{
+		Hook.Projectile->CableComponent->CableGravityScale = Hook.bAttached ? CableGravityScaleAfterHit : CableGravityScaleBeforeHit;
+		Hook.Projectile->CableComponent->SetAttachEndToComponent(GetCableAttachComponent(), CableAttachComponentSocket);
 		if (IsLocalInstigator())
 		{
-			GrappleProjectile->SetFirstPersonCableMaterial();
+			Hook.Projectile->SetFirstPersonCableMaterial();
+			// Hook restored from save was never shot by this client, yet it has to be retracted as usual
+			Hook.bRetracted = false;
+		}
+		else
+		{
+			// Pooled projectile may have been shot by local player before
+			Hook.Projectile->SetThirdPersonCableMaterial();
 		}
 	}
-	else if (!bRetracted)
+	else if (!Hook.bRetracted)
 	{
-		bRetracted = true;
-		OnGrappleStartedRetracting();
-		OnGrappleFinishedRetracting();
+		Hook.bRetracted = true;
+		NotifyHookRetracted(HookIndex);
 	}
+	UpdateTickState();
 }
 
-void AGrapplingHookTool::OnRep_GrappleAttached()
+void AGrapplingHookTool::OnHookAttachedChanged(const int32 HookIndex)
 {
-	if (bGrappleAttached && GrappleProjectile)
+	FGrappleHook& Hook = Hooks[HookIndex];
+	if (Hook.IsAttached())
 	{
-		GrappleProjectile->CableComponent->CableGravityScale = CableGravityScaleAfterHit;
-		OnGrappleAttached();
+		Hook.Projectile->CableComponent->CableGravityScale = CableGravityScaleAfterHit;
+		if (GetNetMode() == NM_Client)
+		{
+			ApplyCableLength(HookIndex, GetAttachedVisualCableLength(HookIndex));
+		}
+		NotifyHookAttached(HookIndex);
 	}
-	else if (!bGrappleAttached && !GrappleProjectile && !bRetracted)
+	else if (!Hook.bAttached && !Hook.Projectile && !Hook.bRetracted)
 	{
-		bRetracted = true;
-		OnGrappleStartedRetracting();
-		OnGrappleFinishedRetracting();
+		Hook.bRetracted = true;
+		NotifyHookRetracted(HookIndex);
+	}
+	UpdateTickState();
+}
+
+EGrapplingHookTickState AGrapplingHookTool::ResolveTickState() const
+{
+	const bool bLocal = IsLocalInstigator();
+	if ((bLocal || HasAuthority()) && Hooks.ContainsByPredicate([](const FGrappleHook& Hook) { return Hook.IsFlying(); }))
+	{
+		return EGrapplingHookTickState::Flying;
+	}
+	// Owning client waits for server to confirm the shot
+	if (bLocal && Hooks.ContainsByPredicate([](const FGrappleHook& Hook) { return Hook.IsAwaitingShot(); }))
+	{
+		return EGrapplingHookTickState::Flying;
+	}
+	// Server simulation of attached hooks is done by UGrapplingHookManagerSubsystem
+	if (bLocal && IsGrappleAttached())
+	{
+		return EGrapplingHookTickState::Attached;
+	}
+	if (bLocal && CrosshairHighlightWidget && Hooks.ContainsByPredicate([](const FGrappleHook& Hook) { return !Hook.Projectile; }))
+	{
+		return EGrapplingHookTickState::Crosshair;
+	}
+	return EGrapplingHookTickState::Idle;
+}
+
+void AGrapplingHookTool::UpdateTickState()
+{
+	const EGrapplingHookTickState NewState = ResolveTickState();
+	if (NewState == TickState)
+	{
+		return;
+	}
+	TickState = NewState;
+
+	switch (TickState)
+	{
+	case EGrapplingHookTickState::Crosshair:
+		SetActorTickInterval(CrosshairTickInterval);
+		break;
+	case EGrapplingHookTickState::Flying:
+		SetActorTickInterval(FlyingTickInterval);
+		break;
+	case EGrapplingHookTickState::Attached:
+		SetActorTickInterval(AttachedTickInterval);
+		break;
+	default:
+		break;
+	}
+	SetActorTickEnabled(TickState != EGrapplingHookTickState::Idle);
+}
+
+void AGrapplingHookTool::OnHookDesiredCableLengthChanged(const int32 HookIndex)
+{
+	const FGrappleHook& Hook = Hooks[HookIndex];
+	NotifyHookCableLengthChanged(HookIndex, Hook.DesiredCableLength / GetMaxCableLength());
+
+	// Server applies visual length after every tension tick, clients derive it from desired length
+	if (Hook.bAttached && GetNetMode() == NM_Client)
+	{
+		ApplyCableLength(HookIndex, GetAttachedVisualCableLength(HookIndex));
+	}
+}
+
+void AGrapplingHookTool::OnRep_CableState()
+{
+	if (CableState.HasVelocity())
+	{
+		if (IsPredictingTension())
+		{
+			ReconcilePredictedTension(CableState.GetVelocity());
+		}
+		else
+		{
+			ApplyInstigatorVelocity(CableState.GetVelocity());
+		}
 	}
 }
 
-void AGrapplingHookTool::OnRep_DesiredCableLength()
+bool AGrapplingHookTool::IsPredictingTension() const
+{
+	// Pulled bodies are simulated by physics, there is nothing to predict on instigator
+	return bPredictTension && !HasAuthority() && IsLocalInstigator() && IsPullingInstigator();
+}
+
+void AGrapplingHookTool::TickPredictedTension(const float DeltaSeconds)
 {
-	OnDesiredCableLengthChanged(DesiredCableLength / GetMaxCableLength());
+	const AFGCharacterPlayer* Player = GetInstigatorCharacter();
+	UFGCharacterMovementComponent* Movement = Player ? Player->GetFGMovementComponent() : nullptr;
+	if (!Movement)
+	{
+		return;
+	}
+
+	// Same step server runs, but without sending anything
+	UpdateCablePaths();
+	TickTensionForce(DeltaSeconds, false);
+
+	// Blend in correction from the last reconciliation
+	if (!PendingPredictionCorrection.IsNearlyZero())
+	{
+		const FVector Correction = PendingPredictionCorrection * FMath::Min(1.0f, DeltaSeconds * PredictionCorrectionRate);
+		Movement->Velocity += Correction;
+		PendingPredictionCorrection -= Correction;
+	}
+
+	PredictionHistory.Record(GetWorld()->GetTimeSeconds(), Movement->Velocity);
+}
+
+void AGrapplingHookTool::ReconcilePredictedTension(const FVector& ServerVelocity)
+{
+	// Server velocity answers client movement which took half of round trip to reach it, and took another half to come
+	// back, so it matches what client predicted about one full round trip ago
+	const FGrapplePredictionFrame* PredictedFrame = PredictionHistory.FindClosestToTime(GetWorld()->GetTimeSeconds() - GetRoundTripTime());
+	if (!PredictedFrame)
+	{
+		ApplyInstigatorVelocity(ServerVelocity);
+		return;
+	}
+
+	const FVector Error = ServerVelocity - PredictedFrame->Velocity;
+	if (Error.SizeSquared() > FMath::Square(PredictionSnapThreshold))
+	{
+		// Too far off to hide it, take server's word immediately
+		if (const AFGCharacterPlayer* Player = GetInstigatorCharacter())
+		{
+			if (UFGCharacterMovementComponent* Movement = Player->GetFGMovementComponent())
+			{
+				Movement->Velocity += Error;
+			}
+		}
+		PendingPredictionCorrection = FVector::ZeroVector;
+		PredictionHistory.Reset();
+		return;
+	}
+	PendingPredictionCorrection = Error;
 }
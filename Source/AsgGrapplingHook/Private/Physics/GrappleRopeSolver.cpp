@@ -0,0 +1,173 @@
+﻿#include "Physics/GrappleRopeSolver.h"
+
+#include "AsgGrapplingHookStats.h"
+#include "Math/VectorRegister.h"
+
+namespace GrappleRope
+{
+	// Padding of particle arrays, so loads of four floats starting at any particle stay in bounds
+	constexpr int32 SimdPadding = 4;
+
+	void ResizePadded(TArray<float>& Array, const int32 Num)
+	{
+		Array.SetNumZeroed(Num + SimdPadding, EAllowShrinking::No);
+	}
+}
+
+void FGrappleRopeSolver::Initialize(const int32 InNumParticles, const FVector& Start, const FVector& End)
+{
+	NumParticles = FMath::Max(2, InNumParticles);
+	for (TArray<float>* Array : {&PositionX, &PositionY, &PositionZ, &PreviousX, &PreviousY, &PreviousZ, &CorrectionX, &CorrectionY, &CorrectionZ})
+	{
+		GrappleRope::ResizePadded(*Array, NumParticles);
+	}
+
+	Origin = Start;
+	const FVector3f Delta = FVector3f(End - Start);
+	for (int32 Index = 0; Index < NumParticles; ++Index)
+	{
+		const FVector3f Position = Delta * (static_cast<float>(Index) / (NumParticles - 1));
+		PositionX[Index] = PreviousX[Index] = Position.X;
+		PositionY[Index] = PreviousY[Index] = Position.Y;
+		PositionZ[Index] = PreviousZ[Index] = Position.Z;
+	}
+}
+
+void FGrappleRopeSolver::Step(const float DeltaSeconds, const FVector& Start, const FVector& End, const float RestLength, const int32 Iterations, const FVector& Gravity)
+{
+	ASG_GRAPPLE_TRACE_SCOPE(AsgGrapple_RopeStep);
+	if (NumParticles < 2)
+	{
+		return;
+	}
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Rebase(Start);
+	const FVector3f LocalEnd = FVector3f(End - Origin);
+
+	Integrate(DeltaSeconds, FVector3f(Gravity));
+	Pin(FVector3f::ZeroVector, LocalEnd);
+
+	const float SegmentLength = RestLength / (NumParticles - 1);
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		RelaxConstraints(SegmentLength);
+		Pin(FVector3f::ZeroVector, LocalEnd);
+	}
+
+	LastStepStats.NumParticles = NumParticles;
+	LastStepStats.Iterations = Iterations;
+	LastStepStats.StepMilliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+}
+
+FVector FGrappleRopeSolver::GetParticleLocation(const int32 Index) const
+{
+	return Origin + FVector(PositionX[Index], PositionY[Index], PositionZ[Index]);
+}
+
+void FGrappleRopeSolver::GetParticleLocations(TArray<FVector>& OutLocations) const
+{
+	OutLocations.SetNumUninitialized(NumParticles, EAllowShrinking::No);
+	for (int32 Index = 0; Index < NumParticles; ++Index)
+	{
+		OutLocations[Index] = GetParticleLocation(Index);
+	}
+}
+
+void FGrappleRopeSolver::Rebase(const FVector& NewOrigin)
+{
+	const FVector3f Shift = FVector3f(Origin - NewOrigin);
+	Origin = NewOrigin;
+	if (Shift.IsZero())
+	{
+		return;
+	}
+	for (int32 Index = 0; Index < NumParticles; ++Index)
+	{
+		PositionX[Index] += Shift.X; PreviousX[Index] += Shift.X;
+		PositionY[Index] += Shift.Y; PreviousY[Index] += Shift.Y;
+		PositionZ[Index] += Shift.Z; PreviousZ[Index] += Shift.Z;
+	}
+}
+
+void FGrappleRopeSolver::Integrate(const float DeltaSeconds, const FVector3f& Gravity)
+{
+	const float Retain = 1.0f - Damping;
+	const FVector3f Acceleration = Gravity * DeltaSeconds * DeltaSeconds;
+	for (int32 Index = 0; Index < NumParticles; ++Index)
+	{
+		const float X = PositionX[Index];
+		const float Y = PositionY[Index];
+		const float Z = PositionZ[Index];
+		PositionX[Index] += (X - PreviousX[Index]) * Retain + Acceleration.X;
+		PositionY[Index] += (Y - PreviousY[Index]) * Retain + Acceleration.Y;
+		PositionZ[Index] += (Z - PreviousZ[Index]) * Retain + Acceleration.Z;
+		PreviousX[Index] = X;
+		PreviousY[Index] = Y;
+		PreviousZ[Index] = Z;
+	}
+}
+
+void FGrappleRopeSolver::RelaxConstraints(const float SegmentLength)
+{
+	const int32 NumSegments = NumParticles - 1;
+
+	// Correction of every segment: both its particles move by half of the length error along the segment
+	const VectorRegister4Float RestLength = VectorSetFloat1(SegmentLength);
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float MinLengthSquared = VectorSetFloat1(UE_KINDA_SMALL_NUMBER);
+	int32 Segment = 0;
+	for (; Segment + 4 <= NumSegments; Segment += 4)
+	{
+		const VectorRegister4Float DX = VectorSubtract(VectorLoad(&PositionX[Segment + 1]), VectorLoad(&PositionX[Segment]));
+		const VectorRegister4Float DY = VectorSubtract(VectorLoad(&PositionY[Segment + 1]), VectorLoad(&PositionY[Segment]));
+		const VectorRegister4Float DZ = VectorSubtract(VectorLoad(&PositionZ[Segment + 1]), VectorLoad(&PositionZ[Segment]));
+		const VectorRegister4Float LengthSquared = VectorMax(VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ))), MinLengthSquared);
+		const VectorRegister4Float InvLength = VectorReciprocalSqrt(LengthSquared);
+		const VectorRegister4Float Length = VectorMultiply(LengthSquared, InvLength);
+		const VectorRegister4Float Scale = VectorMultiply(VectorMultiply(VectorSubtract(Length, RestLength), InvLength), Half);
+		VectorStore(VectorMultiply(DX, Scale), &CorrectionX[Segment]);
+		VectorStore(VectorMultiply(DY, Scale), &CorrectionY[Segment]);
+		VectorStore(VectorMultiply(DZ, Scale), &CorrectionZ[Segment]);
+	}
+	for (; Segment < NumSegments; ++Segment)
+	{
+		const float DX = PositionX[Segment + 1] - PositionX[Segment];
+		const float DY = PositionY[Segment + 1] - PositionY[Segment];
+		const float DZ = PositionZ[Segment + 1] - PositionZ[Segment];
+		const float Length = FMath::Sqrt(FMath::Max(DX * DX + DY * DY + DZ * DZ, UE_KINDA_SMALL_NUMBER));
+		const float Scale = (Length - SegmentLength) / Length * 0.5f;
+		CorrectionX[Segment] = DX * Scale;
+		CorrectionY[Segment] = DY * Scale;
+		CorrectionZ[Segment] = DZ * Scale;
+	}
+
+	// Every particle is pulled by the segment after it and pushed by the segment before it (ends are pinned afterwards)
+	CorrectionX[NumSegments] = CorrectionY[NumSegments] = CorrectionZ[NumSegments] = 0;
+	PositionX[0] += CorrectionX[0];
+	PositionY[0] += CorrectionY[0];
+	PositionZ[0] += CorrectionZ[0];
+	int32 Particle = 1;
+	for (; Particle + 4 <= NumParticles; Particle += 4)
+	{
+		VectorStore(VectorAdd(VectorLoad(&PositionX[Particle]), VectorSubtract(VectorLoad(&CorrectionX[Particle]), VectorLoad(&CorrectionX[Particle - 1]))), &PositionX[Particle]);
+		VectorStore(VectorAdd(VectorLoad(&PositionY[Particle]), VectorSubtract(VectorLoad(&CorrectionY[Particle]), VectorLoad(&CorrectionY[Particle - 1]))), &PositionY[Particle]);
+		VectorStore(VectorAdd(VectorLoad(&PositionZ[Particle]), VectorSubtract(VectorLoad(&CorrectionZ[Particle]), VectorLoad(&CorrectionZ[Particle - 1]))), &PositionZ[Particle]);
+	}
+	for (; Particle < NumParticles; ++Particle)
+	{
+		PositionX[Particle] += CorrectionX[Particle] - CorrectionX[Particle - 1];
+		PositionY[Particle] += CorrectionY[Particle] - CorrectionY[Particle - 1];
+		PositionZ[Particle] += CorrectionZ[Particle] - CorrectionZ[Particle - 1];
+	}
+}
+
+void FGrappleRopeSolver::Pin(const FVector3f& Start, const FVector3f& End)
+{
+	PositionX[0] = Start.X;
+	PositionY[0] = Start.Y;
+	PositionZ[0] = Start.Z;
+	PositionX[NumParticles - 1] = End.X;
+	PositionY[NumParticles - 1] = End.Y;
+	PositionZ[NumParticles - 1] = End.Z;
+}
@@ -0,0 +1,239 @@
+﻿#include "Physics/GrappleSwingRecording.h"
+
+#include "AsgGrapplingHook.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+namespace GrappleSwingFile
+{
+	constexpr uint32 Magic = 0x57534741; // "AGSW"
+	// Any number of cables per frame; version 1 files (exactly one cable per frame) are not read anymore
+	constexpr uint32 Version = 2;
+	// Frame without constraints (velocity, location, floor normal, constraint count, five scalars, output velocity,
+	// substeps, movement mode and flags)
+	constexpr int64 MinFrameSize = 4 * sizeof(FVector3f) + 5 * sizeof(float) + 4 * sizeof(uint8);
+
+	enum EFlags : uint8
+	{
+		Walking = 1 << 0,
+		FixedTimestep = 1 << 1,
+		Tense = 1 << 2,
+		TakeOff = 1 << 3,
+		Tear = 1 << 4
+	};
+
+	// Vectors and scalars are stored in single precision (~100 bytes per frame with one cable)
+	void SerializeVector(FArchive& Ar, FVector& Vector)
+	{
+		FVector3f Value(Vector);
+		Ar << Value;
+		Vector = FVector(Value);
+	}
+
+	void SerializeConstraint(FArchive& Ar, FGrappleTensionConstraint& Constraint)
+	{
+		SerializeVector(Ar, Constraint.ForcePoint);
+		Ar << Constraint.CableLength;
+		Ar << Constraint.DesiredCableLength;
+	}
+
+	void SerializeFrame(FArchive& Ar, FGrappleSwingFrame& Frame)
+	{
+		FGrappleTensionBatchItem& Item = Frame.Item;
+		SerializeVector(Ar, Item.Input.Velocity);
+		SerializeVector(Ar, Item.Input.CharacterLocation);
+		SerializeVector(Ar, Item.Input.FloorNormal);
+		uint8 NumConstraints = static_cast<uint8>(FMath::Min(Item.Input.Constraints.Num(), static_cast<int32>(MAX_uint8)));
+		Ar << NumConstraints;
+		Item.Input.Constraints.SetNum(NumConstraints);
+		for (FGrappleTensionConstraint& Constraint : Item.Input.Constraints)
+		{
+			SerializeConstraint(Ar, Constraint);
+		}
+		Ar << Item.DeltaSeconds;
+		Ar << Item.TearingDistance;
+		Ar << Item.FixedTimestep;
+		Ar << Frame.TimeAccumulatorBefore;
+		Ar << Item.TimeAccumulator;
+		SerializeVector(Ar, Item.Output.Velocity);
+
+		uint8 MaxSubsteps = static_cast<uint8>(FMath::Clamp(Item.MaxSubsteps, 0, MAX_uint8));
+		Ar << MaxSubsteps;
+		Item.MaxSubsteps = MaxSubsteps;
+		Ar << Frame.MovementMode;
+
+		uint8 Flags = (Item.Input.bWalking ? Walking : 0) | (Item.bFixedTimestep ? FixedTimestep : 0)
+			| (Item.Output.bTense ? Tense : 0) | (Item.Output.bTakeOff ? TakeOff : 0) | (Item.bTear ? Tear : 0);
+		Ar << Flags;
+		Item.Input.bWalking = (Flags & Walking) != 0;
+		Item.bFixedTimestep = (Flags & FixedTimestep) != 0;
+		Item.Output.bTense = (Flags & Tense) != 0;
+		Item.Output.bTakeOff = (Flags & TakeOff) != 0;
+		Item.bTear = (Flags & Tear) != 0;
+	}
+}
+
+void FGrappleSwingRecorder::Initialize(const int32 InCapacity)
+{
+	Capacity = FMath::Max(0, InCapacity);
+	Frames.Empty(Capacity);
+	Head = 0;
+}
+
+void FGrappleSwingRecorder::Record(const FGrappleSwingFrame& Frame)
+{
+	if (Frames.Num() < Capacity)
+	{
+		Frames.Add(Frame);
+		return;
+	}
+	if (Frames.Num() == 0)
+	{
+		return;
+	}
+	Frames[Head] = Frame;
+	Head = (Head + 1) % Frames.Num();
+}
+
+void FGrappleSwingRecorder::Reset()
+{
+	Frames.Reset();
+	Head = 0;
+}
+
+void FGrappleSwingRecorder::GetFrames(TArray<FGrappleSwingFrame>& OutFrames) const
+{
+	OutFrames.Reset(Frames.Num());
+	for (int32 Index = 0; Index < Frames.Num(); ++Index)
+	{
+		OutFrames.Add(Frames[(Head + Index) % Frames.Num()]);
+	}
+}
+
+bool FGrappleSwingRecorder::SaveToFile(const FString& FileName) const
+{
+	if (Frames.Num() == 0)
+	{
+		return false;
+	}
+	const TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FileName));
+	if (!Writer)
+	{
+		return false;
+	}
+
+	uint32 Magic = GrappleSwingFile::Magic;
+	uint32 Version = GrappleSwingFile::Version;
+	int32 NumFrames = Frames.Num();
+	*Writer << Magic << Version << NumFrames;
+	for (int32 Index = 0; Index < Frames.Num(); ++Index)
+	{
+		FGrappleSwingFrame Frame = Frames[(Head + Index) % Frames.Num()];
+		GrappleSwingFile::SerializeFrame(*Writer, Frame);
+	}
+	return Writer->Close();
+}
+
+bool FGrappleSwingRecorder::LoadFromFile(const FString& FileName, TArray<FGrappleSwingFrame>& OutFrames)
+{
+	const TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FileName));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumFrames = 0;
+	*Reader << Magic << Version << NumFrames;
+	if (Reader->IsError() || Magic != GrappleSwingFile::Magic || NumFrames < 0
+		|| Version != GrappleSwingFile::Version)
+	{
+		return false;
+	}
+	// Corrupted frame count must not allocate more than the file could hold
+	if (NumFrames > (Reader->TotalSize() - Reader->Tell()) / GrappleSwingFile::MinFrameSize)
+	{
+		return false;
+	}
+
+	OutFrames.SetNum(NumFrames);
+	for (FGrappleSwingFrame& Frame : OutFrames)
+	{
+		GrappleSwingFile::SerializeFrame(*Reader, Frame);
+	}
+	return !Reader->IsError();
+}
+
+FGrappleSwingReplayResult FGrappleSwingReplay::Run(const TArray<FGrappleSwingFrame>& Frames, const float VelocityTolerance)
+{
+	FGrappleSwingReplayResult Result;
+	Result.NumFrames = Frames.Num();
+
+	TArray<FGrappleTensionBatchItem> Items;
+	Items.Reserve(Frames.Num());
+	for (const FGrappleSwingFrame& Frame : Frames)
+	{
+		FGrappleTensionBatchItem& Item = Items.Add_GetRef(Frame.Item);
+		Item.TimeAccumulator = Frame.TimeAccumulatorBefore;
+		Item.Output = FGrappleTensionOutput();
+		Item.bTear = false;
+		Item.TornConstraint = INDEX_NONE;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (FGrappleTensionBatchItem& Item : Items)
+	{
+		FGrappleTensionSolver::Solve(Item);
+	}
+	Result.SolveSeconds = FPlatformTime::Seconds() - StartTime;
+
+	for (int32 Index = 0; Index < Frames.Num(); ++Index)
+	{
+		const FGrappleTensionBatchItem& Recorded = Frames[Index].Item;
+		const FGrappleTensionBatchItem& Replayed = Items[Index];
+		const float VelocityError = FVector::Distance(Recorded.Output.Velocity, Replayed.Output.Velocity);
+		Result.MaxVelocityError = FMath::Max(Result.MaxVelocityError, VelocityError);
+
+		if (VelocityError > VelocityTolerance || Recorded.bTear != Replayed.bTear
+			|| Recorded.Output.bTense != Replayed.Output.bTense || Recorded.Output.bTakeOff != Replayed.Output.bTakeOff)
+		{
+			Result.NumMismatches++;
+			if (Result.FirstMismatchFrame == INDEX_NONE)
+			{
+				Result.FirstMismatchFrame = Index;
+			}
+		}
+	}
+	return Result;
+}
+
+static FAutoConsoleCommand CVarReplayGrappleSwing(
+	TEXT("AsgGrapple.ReplaySwing"),
+	TEXT("Re-runs tension solver against swing recording and reports differences. Usage: AsgGrapple.ReplaySwing <file> [velocity tolerance]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() < 1)
+		{
+			UE_LOG(LogAsgGrapple, Display, TEXT("Usage: AsgGrapple.ReplaySwing <file> [velocity tolerance]"));
+			return;
+		}
+
+		FString FileName = Args[0];
+		if (FPaths::IsRelative(FileName))
+		{
+			FileName = FPaths::ProjectSavedDir() / TEXT("GrappleSwings") / FileName;
+		}
+		TArray<FGrappleSwingFrame> Frames;
+		if (!FGrappleSwingRecorder::LoadFromFile(FileName, Frames))
+		{
+			UE_LOG(LogAsgGrapple, Error, TEXT("Failed to load swing recording %s"), *FileName);
+			return;
+		}
+
+		const float Tolerance = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.1f;
+		const FGrappleSwingReplayResult Result = FGrappleSwingReplay::Run(Frames, Tolerance);
+		UE_LOG(LogAsgGrapple, Display, TEXT("Replayed %d frames of %s in %.3f ms: %d mismatches (first at %d), max velocity error %.3f"),
+			Result.NumFrames, *FileName, Result.SolveSeconds * 1000.0, Result.NumMismatches, Result.FirstMismatchFrame, Result.MaxVelocityError);
+	}));
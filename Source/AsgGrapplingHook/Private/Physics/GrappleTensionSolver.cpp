@@ -0,0 +1,155 @@
+﻿#include "Physics/GrappleTensionSolver.h"
+
+namespace GrappleTension
+{
+	// How fast velocity away from grapple point is cancelled in the air (per second)
+	constexpr float AirTensionRate = 3;
+	// How strong cable pulls character per unit of length exceeding desired length (per second)
+	constexpr float ExcessDistancePullRate = 10;
+	// Maximum floor normal to tension direction angle at which character takes off the ground (~43 degrees)
+	constexpr float TakeOffMaxAngle = PI/4 - PI/64;
+	// Solver passes over cables when several of them hold the character at once
+	constexpr int32 ConstraintIterations = 4;
+}
+
+FGrappleTensionOutput FGrappleTensionSolver::Step(const FGrappleTensionInput& Input, const float DeltaSeconds)
+{
+	FGrappleTensionOutput Output;
+	Output.Velocity = Input.Velocity;
+
+	// Directions and targets of tense cables. A cable only cancels velocity away from its force point: velocity along
+	// its direction must not get below the target, which leaves part of the outward velocity in the air, so the rope
+	// feels stretchable. On the ground player has friction (much more resistance to external forces), so it's cancelled fully.
+	const float CancelRate = Input.bWalking ? 1 : DeltaSeconds * GrappleTension::AirTensionRate;
+	TArray<FVector, TInlineAllocator<2>> Directions;
+	TArray<float, TInlineAllocator<2>> TargetSpeeds;
+	for (const FGrappleTensionConstraint& Constraint : Input.Constraints)
+	{
+		if (Constraint.CableLength < Constraint.DesiredCableLength)
+		{
+			continue;
+		}
+		Output.bTense = true;
+
+		const FVector Direction = (Constraint.ForcePoint - Input.CharacterLocation).GetSafeNormal();
+		const float Speed = FVector::DotProduct(Input.Velocity, Direction);
+		Directions.Add(Direction);
+		// Moving towards force point already, nothing to cancel
+		TargetSpeeds.Add(Speed < 0 ? Speed * (1 - CancelRate) : -UE_BIG_NUMBER);
+	}
+	if (!Output.bTense)
+	{
+		return Output;
+	}
+
+	// Projected Gauss-Seidel: accumulated impulse along each direction is never negative (cable only pulls), and every
+	// pass corrects what other cables' impulses changed. A single cable is solved exactly by the first pass.
+	TArray<float, TInlineAllocator<2>> Impulses;
+	Impulses.SetNumZeroed(Directions.Num());
+	const int32 NumIterations = Directions.Num() > 1 ? GrappleTension::ConstraintIterations : 1;
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		for (int32 Index = 0; Index < Directions.Num(); ++Index)
+		{
+			const float Error = TargetSpeeds[Index] - FVector::DotProduct(Output.Velocity, Directions[Index]);
+			const float NewImpulse = FMath::Max(0.0f, Impulses[Index] + Error);
+			Output.Velocity += Directions[Index] * (NewImpulse - Impulses[Index]);
+			Impulses[Index] = NewImpulse;
+		}
+	}
+
+	// If cable is longer than desired length allows, tension should pull player towards grapple point
+	int32 DirectionIndex = 0;
+	for (const FGrappleTensionConstraint& Constraint : Input.Constraints)
+	{
+		if (Constraint.CableLength < Constraint.DesiredCableLength)
+		{
+			continue;
+		}
+		const FVector& Direction = Directions[DirectionIndex++];
+		if (Constraint.CableLength > Constraint.DesiredCableLength)
+		{
+			const float ExcessDistance = Constraint.CableLength - Constraint.DesiredCableLength;
+			Output.Velocity += Direction * ExcessDistance * DeltaSeconds * GrappleTension::ExcessDistancePullRate;
+		}
+	}
+
+	// Help player to automatically take off the ground if floor normal to tension force angle is small enough
+	if (Input.bWalking)
+	{
+		for (const FVector& Direction : Directions)
+		{
+			const float Dot = FMath::Clamp(FVector::DotProduct(Input.FloorNormal, Direction), -1.0f, 1.0f);
+			Output.bTakeOff |= FMath::Acos(Dot) < GrappleTension::TakeOffMaxAngle;
+		}
+	}
+
+	return Output;
+}
+
+void FGrappleTensionSolver::Solve(FGrappleTensionBatchItem& Item)
+{
+	Item.TornConstraint = Item.Input.Constraints.IndexOfByPredicate([&Item](const FGrappleTensionConstraint& Constraint)
+	{
+		return Constraint.CableLength - Constraint.DesiredCableLength >= Item.TearingDistance;
+	});
+	Item.bTear = Item.TornConstraint != INDEX_NONE;
+	if (Item.bTear)
+	{
+		Item.Output = FGrappleTensionOutput();
+		Item.Output.Velocity = Item.Input.Velocity;
+		return;
+	}
+
+	Item.Output = Item.bFixedTimestep
+		? Integrate(Item.Input, Item.DeltaSeconds, Item.FixedTimestep, Item.MaxSubsteps, Item.TimeAccumulator)
+		: Step(Item.Input, Item.DeltaSeconds);
+}
+
+FGrappleTensionOutput FGrappleTensionSolver::Integrate(const FGrappleTensionInput& Input, const float DeltaSeconds,
+	const float FixedTimestep, const int32 MaxSubsteps, float& InOutAccumulator)
+{
+	FGrappleTensionOutput Output;
+	Output.Velocity = Input.Velocity;
+	if (FixedTimestep <= 0 || MaxSubsteps <= 0)
+	{
+		return Output;
+	}
+
+	InOutAccumulator = FMath::Min(InOutAccumulator + DeltaSeconds, FixedTimestep * MaxSubsteps);
+
+	// Part of cable length that doesn't change while character moves (cable turns, shooting source offset)
+	TArray<float, TInlineAllocator<2>> CableLengthOffsets;
+	for (const FGrappleTensionConstraint& Constraint : Input.Constraints)
+	{
+		CableLengthOffsets.Add(Constraint.CableLength - FVector::Distance(Constraint.ForcePoint, Input.CharacterLocation));
+	}
+
+	FGrappleTensionInput SubstepInput = Input;
+	bool bStepped = false;
+	while (InOutAccumulator >= FixedTimestep || (!bStepped && InOutAccumulator > 0))
+	{
+		// Frames shorter than fixed timestep (high frame rates) are simulated with a step of their own length instead
+		// of waiting for the accumulator to fill, otherwise tension would only be applied every few frames and judder
+		const float SubstepTime = FMath::Min(InOutAccumulator, FixedTimestep);
+		InOutAccumulator -= SubstepTime;
+		bStepped = true;
+
+		const FGrappleTensionOutput SubstepOutput = Step(SubstepInput, SubstepTime);
+		Output.Velocity = SubstepOutput.Velocity;
+		Output.bTense |= SubstepOutput.bTense;
+		Output.bTakeOff |= SubstepOutput.bTakeOff;
+
+		// Predict where character will be at the next substep, movement component will do the actual move afterwards
+		SubstepInput.Velocity = SubstepOutput.Velocity;
+		SubstepInput.CharacterLocation += SubstepOutput.Velocity * SubstepTime;
+		for (int32 Index = 0; Index < SubstepInput.Constraints.Num(); ++Index)
+		{
+			FGrappleTensionConstraint& Constraint = SubstepInput.Constraints[Index];
+			Constraint.CableLength = FVector::Distance(Constraint.ForcePoint, SubstepInput.CharacterLocation) + CableLengthOffsets[Index];
+		}
+		SubstepInput.bWalking &= !SubstepOutput.bTakeOff;
+	}
+
+	return Output;
+}
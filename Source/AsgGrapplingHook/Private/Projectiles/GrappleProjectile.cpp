@@ -1,33 +1,340 @@
 ﻿#include "Projectiles/GrappleProjectile.h"
 #include "CableComponent.h"
 #include "Components/SphereComponent.h"
+#include "Components/SplineMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "AsgGrapplingHook.h"
+#include "AsgGrapplingHookSettings.h"
 
 AGrappleProjectile::AGrappleProjectile()
 {
 	CableComponent = CreateDefaultSubobject<UCableComponent>("CableRender");
 	CableComponent->SetupAttachment(RootComponent);
+
+	PrimaryActorTick.bCanEverTick = true;
 	
-	mShouldAttachOnImpact = true;
+	// Grapple tool anchors projectile relative to hit component instead (see FGrappleAnchor)
+	mShouldAttachOnImpact = false;
 }
 
 void AGrappleProjectile::SetFirstPersonCableMaterial()
 {
-	CableComponent->SetMaterial(0, CableMaterial1P);
+	SetRopeMaterial(CableMaterial1P);
 	bWasMaterial1P = true;
 }
 
+void AGrappleProjectile::SetThirdPersonCableMaterial()
+{
+	SetRopeMaterial(CableMaterial);
+	bWasMaterial1P = false;
+}
+
+void AGrappleProjectile::ActivateFromPool(const FVector& Location, const FVector& InitialVelocity)
+{
+	SetNetDormancy(DORM_Awake);
+	SetLifeSpan(0);
+	// Previous shot may have been of the local player; new owner's tool sets first person material again if it's local
+	SetThirdPersonCableMaterial();
+
+	// Move simulated cable particles together with the projectile, so the cable doesn't whip from the previous shot location
+	CableComponent->ApplyWorldOffset(Location - GetActorLocation(), false);
+	SetActorLocation(Location, false, nullptr, ETeleportType::ResetPhysics);
+	CableComponent->CableLength = 0;
+	RopeRestLength = 0;
+	if (bRopeSolverActive)
+	{
+		RopeSolver.Initialize(AuthoredNumSegments + 1, Location, GetCableEndLocation());
+		RopeSolver.GetParticleLocations(RopeParticleLocations);
+		UpdateRopeSegmentComponents();
+	}
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	if (UProjectileMovementComponent* ProjectileMovement = FindComponentByClass<UProjectileMovementComponent>())
+	{
+		ProjectileMovement->SetUpdatedComponent(GetRootComponent());
+		ProjectileMovement->Activate(true);
+	}
+	SetInitialVelocity(InitialVelocity);
+
+	ForceNetUpdate();
+}
+
+void AGrappleProjectile::SettleAtAnchor(const FGrappleAnchor& Anchor)
+{
+	if (UProjectileMovementComponent* ProjectileMovement = FindComponentByClass<UProjectileMovementComponent>())
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->Deactivate();
+	}
+
+	// Every machine resolves anchor by itself, so there is nothing to replicate about projectile's movement
+	SetReplicateMovement(false);
+	SetActorLocation(Anchor.GetWorldLocation(), false, nullptr, ETeleportType::TeleportPhysics);
+	if (USceneComponent* AnchorComponent = Anchor.GetComponent())
+	{
+		AttachToComponent(AnchorComponent, FAttachmentTransformRules::KeepWorldTransform, Anchor.GetBoneName());
+	}
+}
+
+bool AGrappleProjectile::IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const
+{
+	// Pooled projectile
+	if (IsHidden() && !GetActorEnableCollision())
+	{
+		return false;
+	}
+	const APawn* ProjectileInstigator = GetInstigator();
+	if (ProjectileInstigator && (ProjectileInstigator == ViewTarget || ProjectileInstigator->GetController() == RealViewer))
+	{
+		return true;
+	}
+
+	// Cable spans between projectile and instigator, so it's visible when close to either end
+	const UAsgGrapplingHookSettings* Settings = UAsgGrapplingHookSettings::Get();
+	const FVector ProjectileLocation = GetActorLocation();
+	const FVector InstigatorLocation = ProjectileInstigator ? ProjectileInstigator->GetActorLocation() : ProjectileLocation;
+	const float DistanceSquared = FMath::Min(FVector::DistSquared(SrcLocation, ProjectileLocation), FVector::DistSquared(SrcLocation, InstigatorLocation));
+	if (DistanceSquared > FMath::Square(Settings->GrappleNetCullDistance))
+	{
+		return false;
+	}
+	if (Settings->GrappleNetViewConeDistance <= 0 || DistanceSquared <= FMath::Square(Settings->GrappleNetViewConeDistance))
+	{
+		return true;
+	}
+
+	// Distant cable only matters while viewer looks at it. Channel stays open for a few seconds after cable goes out of
+	// view, so looking around doesn't reopen it every time.
+	const APlayerController* ViewerController = Cast<APlayerController>(RealViewer);
+	const FVector ViewDirection = ViewerController ? ViewerController->GetControlRotation().Vector() : ViewTarget->GetActorForwardVector();
+	const float MinCosine = FMath::Cos(FMath::DegreesToRadians(Settings->GrappleNetViewConeHalfAngle));
+	for (const FVector& CablePoint : {ProjectileLocation, (ProjectileLocation + InstigatorLocation) / 2, InstigatorLocation})
+	{
+		if ((ViewDirection | (CablePoint - SrcLocation).GetSafeNormal()) >= MinCosine)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+float AGrappleProjectile::GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget,
+	UActorChannel* InChannel, const float Time, const bool bLowBandwidth)
+{
+	// Engine scales priority by distance and view direction; own grapple drives owner's movement, so it goes first
+	float Priority = Super::GetNetPriority(ViewPos, ViewDir, Viewer, ViewTarget, InChannel, Time, bLowBandwidth);
+	if (const APawn* ProjectileInstigator = GetInstigator();
+		ProjectileInstigator && ProjectileInstigator == ViewTarget)
+	{
+		Priority *= UAsgGrapplingHookSettings::Get()->OwnGrappleNetPriorityScale;
+	}
+	return Priority;
+}
+
+void AGrappleProjectile::ReleaseAnchor()
+{
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	SetReplicateMovement(true);
+}
+
+void AGrappleProjectile::DeactivateToPool()
+{
+	// Impact event stays bound; the tool ignores projectiles which are not among its hooks
+	ReleaseAnchor();
+	if (UProjectileMovementComponent* ProjectileMovement = FindComponentByClass<UProjectileMovementComponent>())
+	{
+		ProjectileMovement->StopMovementImmediately();
+		ProjectileMovement->Deactivate();
+	}
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+
+	// Hidden state is replicated before the channel goes dormant
+	ForceNetUpdate();
+	SetNetDormancy(DORM_DormantAll);
+}
+
 void AGrappleProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 
 	CableComponent->EndLocation = FVector::ZeroVector;
-	CableComponent->SetMaterial(0, bWasMaterial1P ? CableMaterial1P : CableMaterial);
+	AuthoredNumSegments = CableComponent->NumSegments;
+	AuthoredSolverIterations = CableComponent->SolverIterations;
+	if (bUseRopeSolver && !RopeSegmentMesh)
+	{
+		UE_LOG(LogAsgGrapple, Warning, TEXT("%s uses rope solver without RopeSegmentMesh, falling back to cable component"), *GetClass()->GetName());
+	}
+	bRopeSolverActive = bUseRopeSolver && RopeSegmentMesh;
+	if (bRopeSolverActive)
+	{
+		CableComponent->SetComponentTickEnabled(false);
+		CableComponent->SetVisibility(false);
+		RopeSolver.Initialize(AuthoredNumSegments + 1, GetActorLocation(), GetCableEndLocation());
+		CreateRopeSegmentComponents();
+		// Segments are laid out straight right away, so their bounds are where the rope is and they can be rendered
+		// (and thus taken out of frozen LOD) before the first simulated step
+		RopeSolver.GetParticleLocations(RopeParticleLocations);
+		UpdateRopeSegmentComponents();
+	}
+	SetRopeMaterial(bWasMaterial1P ? CableMaterial1P : CableMaterial);
+	if (UGrappleCableLODSubsystem* CableLODSubsystem = UGrappleCableLODSubsystem::Get(GetWorld()))
+	{
+		CableLODSubsystem->RegisterCable(this);
+	}
+}
+
+void AGrappleProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGrappleCableLODSubsystem* CableLODSubsystem = UGrappleCableLODSubsystem::Get(GetWorld()))
+	{
+		CableLODSubsystem->UnregisterCable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AGrappleProjectile::SetCableLOD(const EGrappleCableLOD NewLOD)
+{
+	if (NewLOD == CableLOD)
+	{
+		return;
+	}
+	const EGrappleCableLOD PreviousLOD = CableLOD;
+	CableLOD = NewLOD;
+
+	// Frozen cable keeps its shape, it just stops simulating
+	CableComponent->SetComponentTickEnabled(!bRopeSolverActive && NewLOD != EGrappleCableLOD::Frozen);
+	if (NewLOD == EGrappleCableLOD::Frozen || bRopeSolverActive)
+	{
+		return;
+	}
+
+	const UAsgGrapplingHookSettings* Settings = UAsgGrapplingHookSettings::Get();
+	int32 NumSegments = AuthoredNumSegments;
+	int32 SolverIterations = AuthoredSolverIterations;
+	if (NewLOD == EGrappleCableLOD::Reduced)
+	{
+		NumSegments = FMath::Min(AuthoredNumSegments, Settings->CableLODReducedNumSegments);
+		SolverIterations = FMath::Min(AuthoredSolverIterations, Settings->CableLODReducedSolverIterations);
+	}
+	else if (NewLOD == EGrappleCableLOD::Straight)
+	{
+		NumSegments = 1;
+		SolverIterations = 1;
+	}
+
+	CableComponent->SolverIterations = SolverIterations;
+	if (CableComponent->NumSegments != NumSegments)
+	{
+		// Cable particles are allocated on registration, so segment count change requires re-registering the component
+		CableComponent->NumSegments = NumSegments;
+		CableComponent->ReregisterComponent();
+	}
+	else if (PreviousLOD == EGrappleCableLOD::Frozen)
+	{
+		CableComponent->MarkRenderDynamicDataDirty();
+	}
+}
+
+bool AGrappleProjectile::WasCableRecentlyRendered(const float Tolerance) const
+{
+	// Cable component is hidden while rope solver is used, so it never renders; segments and projectile mesh do
+	return bRopeSolverActive ? WasRecentlyRendered(Tolerance) : CableComponent->WasRecentlyRendered(Tolerance);
+}
+
+void AGrappleProjectile::Tick(const float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!bRopeSolverActive || CableLOD == EGrappleCableLOD::Frozen || IsHidden())
+	{
+		return;
+	}
+
+	int32 Iterations = RopeSolverIterations;
+	if (CableLOD == EGrappleCableLOD::Reduced)
+	{
+		Iterations = FMath::Min(Iterations, UAsgGrapplingHookSettings::Get()->CableLODReducedSolverIterations);
+	}
+	else if (CableLOD == EGrappleCableLOD::Straight)
+	{
+		Iterations = 1;
+	}
+
+	// Rest length is the real cable length pushed by the tool. Machines where the tool doesn't tick only know it from
+	// desired length, so a rope that got tense since then is stretched to the distance between its ends.
+	const FVector Start = GetActorLocation();
+	const FVector End = GetCableEndLocation();
+	const float RestLength = FMath::Max(RopeRestLength, FVector::Distance(Start, End));
+	const FVector Gravity(0, 0, GetWorld()->GetGravityZ() * CableComponent->CableGravityScale);
+	RopeSolver.Step(DeltaSeconds, Start, End, RestLength, Iterations, Gravity);
+	RopeSolver.GetParticleLocations(RopeParticleLocations);
+	UpdateRopeSegmentComponents();
+	OnRopeSimulated();
+}
+
+FVector AGrappleProjectile::GetCableEndLocation() const
+{
+	if (const USceneComponent* EndComponent = CableComponent->GetAttachedComponent())
+	{
+		return EndComponent->GetSocketLocation(CableComponent->AttachEndToSocketName);
+	}
+	return CableComponent->GetComponentTransform().TransformPosition(CableComponent->EndLocation);
+}
+
+void AGrappleProjectile::CreateRopeSegmentComponents()
+{
+	const FVector2D Scale(CableComponent->CableWidth);
+	for (int32 Index = 0; Index < RopeSolver.GetNumParticles() - 1; ++Index)
+	{
+		USplineMeshComponent* Segment = NewObject<USplineMeshComponent>(this, NAME_None, RF_Transient);
+		Segment->SetMobility(EComponentMobility::Movable);
+		Segment->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Segment->SetCanEverAffectNavigation(false);
+		// Particles are in world space, so is the segment
+		Segment->SetUsingAbsoluteLocation(true);
+		Segment->SetUsingAbsoluteRotation(true);
+		Segment->SetUsingAbsoluteScale(true);
+		Segment->SetupAttachment(RootComponent);
+		Segment->SetStaticMesh(RopeSegmentMesh);
+		Segment->SetStartScale(Scale, false);
+		Segment->SetEndScale(Scale, false);
+		Segment->RegisterComponent();
+		Segment->SetWorldTransform(FTransform::Identity);
+		RopeSegmentComponents.Add(Segment);
+	}
+}
+
+void AGrappleProjectile::UpdateRopeSegmentComponents()
+{
+	const int32 NumParticles = RopeParticleLocations.Num();
+	for (int32 Index = 0; Index < RopeSegmentComponents.Num() && Index + 1 < NumParticles; ++Index)
+	{
+		// Catmull-Rom tangents, so the rope bends smoothly across segment joints
+		const FVector& Start = RopeParticleLocations[Index];
+		const FVector& End = RopeParticleLocations[Index + 1];
+		const FVector StartTangent = (End - RopeParticleLocations[FMath::Max(Index - 1, 0)]) * 0.5;
+		const FVector EndTangent = (RopeParticleLocations[FMath::Min(Index + 2, NumParticles - 1)] - Start) * 0.5;
+		RopeSegmentComponents[Index]->SetStartAndEnd(Start, StartTangent, End, EndTangent);
+	}
+}
+
+void AGrappleProjectile::SetRopeMaterial(UMaterialInterface* Material)
+{
+	CableComponent->SetMaterial(0, Material);
+	for (USplineMeshComponent* Segment : RopeSegmentComponents)
+	{
+		Segment->SetMaterial(0, Material);
+	}
 }
 
 void AGrappleProjectile::OnImpact_Native(const FHitResult& HitResult)
 {
 	Super::OnImpact_Native(HitResult);
 	
-	OnProjectileImpactEvent.Broadcast(HitResult);
+	OnProjectileImpactEvent.ExecuteIfBound(this, HitResult);
 }
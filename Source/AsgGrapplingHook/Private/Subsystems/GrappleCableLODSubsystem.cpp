@@ -0,0 +1,122 @@
+﻿#include "Subsystems/GrappleCableLODSubsystem.h"
+
+#include "AsgGrapplingHookSettings.h"
+#include "Projectiles/GrappleProjectile.h"
+
+UGrappleCableLODSubsystem* UGrappleCableLODSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGrappleCableLODSubsystem>() : nullptr;
+}
+
+void UGrappleCableLODSubsystem::RegisterCable(AGrappleProjectile* Projectile)
+{
+	if (Projectile)
+	{
+		Cables.AddUnique(Projectile);
+		// Evaluate new cable right away instead of simulating it at full detail until the next update
+		TimeUntilUpdate = 0;
+	}
+}
+
+void UGrappleCableLODSubsystem::UnregisterCable(AGrappleProjectile* Projectile)
+{
+	Cables.RemoveSwap(Projectile, EAllowShrinking::No);
+}
+
+void UGrappleCableLODSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TimeUntilUpdate -= DeltaTime;
+	if (TimeUntilUpdate > 0)
+	{
+		return;
+	}
+	TimeUntilUpdate = UAsgGrapplingHookSettings::Get()->CableLODUpdateInterval;
+
+	UpdateLODs();
+}
+
+TStatId UGrappleCableLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGrappleCableLODSubsystem, STATGROUP_Tickables);
+}
+
+bool UGrappleCableLODSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGrappleCableLODSubsystem::UpdateLODs()
+{
+	const UAsgGrapplingHookSettings* Settings = UAsgGrapplingHookSettings::Get();
+	const UWorld* World = GetWorld();
+	Stats = FGrappleCableLODStats();
+
+	// Nothing is rendered on dedicated server, so there's nothing to simulate cables for
+	FVector ViewLocation = FVector::ZeroVector;
+	FRotator ViewRotation;
+	const APlayerController* LocalController = World->GetNetMode() != NM_DedicatedServer ? World->GetFirstPlayerController() : nullptr;
+	const bool bHasViewer = LocalController && LocalController->IsLocalController();
+	if (bHasViewer)
+	{
+		LocalController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	}
+
+	SortedCables.Reset();
+	for (int32 Index = Cables.Num() - 1; Index >= 0; --Index)
+	{
+		AGrappleProjectile* Cable = Cables[Index];
+		if (!IsValid(Cable))
+		{
+			Cables.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+		if (!bHasViewer || Cable->IsHidden() || !Cable->WasCableRecentlyRendered(Settings->CableLODNotRenderedTime))
+		{
+			Cable->SetCableLOD(EGrappleCableLOD::Frozen);
+			Stats.Frozen++;
+			continue;
+		}
+		SortedCables.Emplace(FVector::DistSquared(ViewLocation, Cable->GetActorLocation()), Index);
+	}
+	SortedCables.Sort([](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+
+	for (const TPair<double, int32>& SortedCable : SortedCables)
+	{
+		AGrappleProjectile* Cable = Cables[SortedCable.Value];
+		const float Distance = FMath::Sqrt(SortedCable.Key);
+
+		// Cables only get more detailed tier once they are well inside its boundary, to avoid flickering between tiers
+		const EGrappleCableLOD CurrentLOD = Cable->GetCableLOD();
+		const float StraightDistance = Settings->CableLODStraightDistance - (CurrentLOD >= EGrappleCableLOD::Straight ? Settings->CableLODHysteresis : 0);
+		const float ReducedDistance = Settings->CableLODReducedDistance - (CurrentLOD >= EGrappleCableLOD::Reduced ? Settings->CableLODHysteresis : 0);
+		EGrappleCableLOD LOD = EGrappleCableLOD::Full;
+		if (Distance > StraightDistance)
+		{
+			LOD = EGrappleCableLOD::Straight;
+		}
+		else if (Distance > ReducedDistance)
+		{
+			LOD = EGrappleCableLOD::Reduced;
+		}
+
+		// Sorted by distance, so budgets are spent on the closest cables
+		if (LOD == EGrappleCableLOD::Full && Stats.Full >= Settings->CableLODMaxFullCables)
+		{
+			LOD = EGrappleCableLOD::Reduced;
+		}
+		if (LOD == EGrappleCableLOD::Reduced && Stats.Reduced >= Settings->CableLODMaxReducedCables)
+		{
+			LOD = EGrappleCableLOD::Straight;
+		}
+
+		Cable->SetCableLOD(LOD);
+		switch (LOD)
+		{
+		case EGrappleCableLOD::Full: Stats.Full++; break;
+		case EGrappleCableLOD::Reduced: Stats.Reduced++; break;
+		default: Stats.Straight++; break;
+		}
+	}
+}
@@ -0,0 +1,73 @@
+﻿#include "Subsystems/GrappleProjectilePoolSubsystem.h"
+
+#include "AsgGrapplingHookStats.h"
+#include "Projectiles/GrappleProjectile.h"
+
+UGrappleProjectilePoolSubsystem* UGrappleProjectilePoolSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGrappleProjectilePoolSubsystem>() : nullptr;
+}
+
+AGrappleProjectile* UGrappleProjectilePoolSubsystem::Acquire(const TSubclassOf<AGrappleProjectile> ProjectileClass, const FVector& Location, const FVector& InitialVelocity)
+{
+	if (!ProjectileClass)
+	{
+		return nullptr;
+	}
+
+	for (int32 Index = DormantProjectiles.Num() - 1; Index >= 0; --Index)
+	{
+		AGrappleProjectile* Projectile = DormantProjectiles[Index];
+		if (!IsValid(Projectile))
+		{
+			DormantProjectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+		if (Projectile->GetClass() != ProjectileClass)
+		{
+			continue;
+		}
+
+		DormantProjectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		Stats.Dormant = DormantProjectiles.Num();
+		Stats.Reused++;
+		INC_DWORD_STAT(STAT_AsgGrapple_ActiveCables);
+		Projectile->ActivateFromPool(Location, InitialVelocity);
+		return Projectile;
+	}
+
+	AGrappleProjectile* Projectile = GetWorld()->SpawnActor<AGrappleProjectile>(ProjectileClass, Location, FRotator::ZeroRotator);
+	if (Projectile)
+	{
+		Stats.Spawned++;
+		INC_DWORD_STAT(STAT_AsgGrapple_ActiveCables);
+		Projectile->SetInitialVelocity(InitialVelocity);
+	}
+	return Projectile;
+}
+
+void UGrappleProjectilePoolSubsystem::Release(AGrappleProjectile* Projectile)
+{
+	if (!IsValid(Projectile))
+	{
+		return;
+	}
+
+	Stats.Released++;
+	DEC_DWORD_STAT(STAT_AsgGrapple_ActiveCables);
+	if (DormantProjectiles.Num() >= MaxDormantProjectiles)
+	{
+		Stats.Destroyed++;
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->DeactivateToPool();
+	DormantProjectiles.Add(Projectile);
+	Stats.Dormant = DormantProjectiles.Num();
+}
+
+bool UGrappleProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
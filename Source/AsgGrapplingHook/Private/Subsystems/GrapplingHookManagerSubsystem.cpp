@@ -0,0 +1,312 @@
+﻿#include "Subsystems/GrapplingHookManagerSubsystem.h"
+
+#include "AsgGrapplingHook.h"
+#include "AsgGrapplingHookSettings.h"
+#include "AsgGrapplingHookStats.h"
+#include "EngineUtils.h"
+#include "FGCharacterPlayer.h"
+#include "Async/ParallelFor.h"
+#include "Equipment/GrapplingHookTool.h"
+#include "GameFramework/PlayerState.h"
+#include "Subsystems/GrapplingHookUpgradesSubsystem.h"
+#include "Misc/Paths.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Physics/PhysicsInterfaceCore.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "Projectiles/GrappleProjectile.h"
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpGrappleStats(
+	TEXT("AsgGrapple.DumpStats"),
+	TEXT("Prints per-player summary of grapple tools, their cable state and network traffic."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(World))
+		{
+			Manager->DumpStats(Ar);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarDumpGrappleRelevancy(
+	TEXT("AsgGrapple.DumpRelevancy"),
+	TEXT("Prints which grapple projectiles every client connection currently receives (server only)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(World))
+		{
+			Manager->DumpRelevancy(Ar);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CVarSaveGrappleSwings(
+	TEXT("AsgGrapple.SaveSwings"),
+	TEXT("Writes swing recordings of all grapple tools to Saved/GrappleSwings (enable recording with AsgGrapple.SwingRecordFrames)."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		if (const UGrapplingHookManagerSubsystem* Manager = UGrapplingHookManagerSubsystem::Get(World))
+		{
+			Manager->SaveSwingRecordings(Ar);
+		}
+	}));
+
+UGrapplingHookManagerSubsystem* UGrapplingHookManagerSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGrapplingHookManagerSubsystem>() : nullptr;
+}
+
+void UGrapplingHookManagerSubsystem::RegisterTool(AGrapplingHookTool* Tool)
+{
+	if (Tool)
+	{
+		Tools.AddUnique(Tool);
+	}
+}
+
+void UGrapplingHookManagerSubsystem::UnregisterTool(AGrapplingHookTool* Tool)
+{
+	Tools.RemoveSwap(Tool, EAllowShrinking::No);
+}
+
+void UGrapplingHookManagerSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_TensionBatch);
+	CSV_SCOPED_TIMING_STAT(AsgGrapple, TensionBatch);
+	const double BatchStartTime = FPlatformTime::Seconds();
+
+	UpdateNetRates();
+
+	// Gather: anything touching actors, components or collision stays on game thread
+	BatchItems.Reset();
+	BatchTools.Reset();
+	for (int32 Index = Tools.Num() - 1; Index >= 0; --Index)
+	{
+		AGrapplingHookTool* Tool = Tools[Index].Get();
+		if (!Tool)
+		{
+			Tools.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// Tool with several hooks may add an item per pulled body on top of the one pulling instigator
+		const int32 NumGathered = Tool->GatherTensionBatchItems(BatchItems, DeltaTime);
+		for (int32 Gathered = 0; Gathered < NumGathered; ++Gathered)
+		{
+			BatchTools.Add(Tool);
+		}
+	}
+
+	// Solve: plain data only
+	SET_DWORD_STAT(STAT_AsgGrapple_AttachedCables, BatchItems.Num());
+	CSV_CUSTOM_STAT(AsgGrapple, AttachedCables, BatchItems.Num(), ECsvCustomStatOp::Set);
+	SolveBatch(BatchItems);
+
+	// Write back; tools may retract and unregister here, which doesn't affect batch arrays
+	PullImpulses.Reset();
+	for (int32 Index = 0; Index < BatchItems.Num(); ++Index)
+	{
+		BatchTools[Index]->ApplyTensionBatchItem(BatchItems[Index], PullImpulses);
+	}
+	ApplyPullImpulses();
+
+	const float BatchTimeMs = (FPlatformTime::Seconds() - BatchStartTime) * 1000.0;
+	if (const float Budget = UAsgGrapplingHookSettings::Get()->TensionBatchBudgetMs;
+		Budget > 0 && BatchTimeMs > Budget)
+	{
+		ReportBudgetOverrun(TensionBatchBudgetOverruns, TEXT("tension batch (ms)"), BatchTimeMs, Budget);
+	}
+}
+
+void UGrapplingHookManagerSubsystem::SolveBatch(const TArrayView<FGrappleTensionBatchItem> Items)
+{
+	ParallelFor(Items.Num(), [Items](const int32 Index)
+	{
+		ASG_GRAPPLE_TRACE_SCOPE(AsgGrapple_SolveTension);
+		FGrappleTensionSolver::Solve(Items[Index]);
+	}, Items.Num() < MinParallelBatchSize ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+void UGrapplingHookManagerSubsystem::ApplyPullImpulses()
+{
+	SET_DWORD_STAT(STAT_AsgGrapple_PulledBodies, PullImpulses.Num());
+	FPhysScene* PhysScene = GetWorld()->GetPhysicsScene();
+	if (PullImpulses.Num() == 0 || !PhysScene)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_AsgGrapple_PullImpulses);
+	// One lock for all bodies instead of one per body; impulse wakes only the body it is applied to
+	FPhysicsCommand::ExecuteWrite(PhysScene, [this]()
+	{
+		for (const FGrapplePullImpulse& Pull : PullImpulses)
+		{
+			const FPhysicsActorHandle& Handle = Pull.Body->GetPhysicsActor();
+			if (FPhysicsInterface::IsValid(Handle))
+			{
+				FPhysicsInterface::AddImpulseAtLocation_AssumesLocked(Handle, Pull.Impulse, Pull.Location);
+			}
+		}
+	});
+}
+
+void UGrapplingHookManagerSubsystem::RecordRejectedRpc()
+{
+	++RejectedRpcs;
+	INC_DWORD_STAT(STAT_AsgGrapple_RejectedRpcs);
+}
+
+void UGrapplingHookManagerSubsystem::UpdateNetRates()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	const float WindowDuration = Now - NetRatesWindowStart;
+	if (WindowDuration < 1.0f)
+	{
+		return;
+	}
+
+	RpcsPerSecond = RpcsInWindow / WindowDuration;
+	CableStateUpdatesPerSecond = CableStateUpdatesInWindow / WindowDuration;
+	CableStateBytesPerSecond = CableStateBytesInWindow / WindowDuration;
+	NetRatesWindowStart = Now;
+	RpcsInWindow = 0;
+	CableStateUpdatesInWindow = 0;
+	CableStateBytesInWindow = 0;
+
+	SET_FLOAT_STAT(STAT_AsgGrapple_RpcsPerSecond, RpcsPerSecond);
+	SET_FLOAT_STAT(STAT_AsgGrapple_CableStateUpdatesPerSecond, CableStateUpdatesPerSecond);
+	CSV_CUSTOM_STAT(AsgGrapple, RpcsPerSecond, RpcsPerSecond, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AsgGrapple, CableStateBytesPerSecond, CableStateBytesPerSecond, ECsvCustomStatOp::Set);
+
+	if (const float Budget = UAsgGrapplingHookSettings::Get()->CableStateBytesPerSecondBudget;
+		Budget > 0 && CableStateBytesPerSecond > Budget)
+	{
+		ReportBudgetOverrun(CableStateTrafficBudgetOverruns, TEXT("cable state traffic (B/s)"), CableStateBytesPerSecond, Budget);
+	}
+}
+
+void UGrapplingHookManagerSubsystem::ReportBudgetOverrun(int32& Overruns, const TCHAR* BudgetName, const float Value, const float Budget)
+{
+	++Overruns;
+
+	const float Now = GetWorld()->GetTimeSeconds();
+	if (LastBudgetWarningTime >= 0 && Now - LastBudgetWarningTime < UAsgGrapplingHookSettings::Get()->BudgetWarningInterval)
+	{
+		return;
+	}
+	LastBudgetWarningTime = Now;
+	// Same count as STAT_AsgGrapple_AttachedCables: items of the last gathered tension batch
+	UE_LOG(LogAsgGrapple, Warning, TEXT("Grapple budget exceeded: %s %.2f > %.2f with %d attached cables (%d overruns so far)"),
+		BudgetName, Value, Budget, BatchItems.Num(), Overruns);
+}
+
+void UGrapplingHookManagerSubsystem::DumpStats(FOutputDevice& Ar) const
+{
+	Ar.Logf(TEXT("Grapple tools: %d attached (simulated here), %.1f RPCs/sec, %.1f cable state updates/sec, %.0f B/s"),
+		Tools.Num(), RpcsPerSecond, CableStateUpdatesPerSecond, CableStateBytesPerSecond);
+	Ar.Logf(TEXT("Rejected RPCs: %d"), RejectedRpcs);
+	Ar.Logf(TEXT("Budget overruns: tension batch %d frames, cable state traffic %d seconds"),
+		TensionBatchBudgetOverruns, CableStateTrafficBudgetOverruns);
+
+	if (const UGrapplingHookUpgradesSubsystem* Upgrades = UGrapplingHookUpgradesSubsystem::Get(GetWorld()))
+	{
+		const FGrapplingHookUpgradesCacheStats& CacheStats = Upgrades->GetCacheStats();
+		Ar.Logf(TEXT("Upgrades cache: %lld hits, %lld misses, %lld invalidations"), CacheStats.Hits, CacheStats.Misses, CacheStats.Invalidations);
+	}
+
+	for (TActorIterator<AGrapplingHookTool> It(GetWorld()); It; ++It)
+	{
+		const AGrapplingHookTool* Tool = *It;
+		const AFGCharacterPlayer* Player = Tool->GetInstigatorCharacter();
+		const APlayerState* PlayerState = Player ? Player->GetPlayerState() : nullptr;
+		const FGrappleCableStateNetStats& NetStats = Tool->GetCableStateNetStats();
+		const FGrappleCableLengthInputStats& InputStats = Tool->GetCableLengthInputStats();
+
+		Ar.Logf(TEXT("  %s: tick %s; cable state %d sent, %lld bytes, %.1f B/s; length input %d sent, %d coalesced"),
+			PlayerState ? *PlayerState->GetPlayerName() : TEXT("<no player>"),
+			*UEnum::GetDisplayValueAsText(Tool->GetTickState()).ToString(),
+			NetStats.StatesSent, NetStats.BytesSent, NetStats.BytesPerSecond,
+			InputStats.RpcsSent, InputStats.RpcsSuppressed);
+		for (int32 HookIndex = 0; HookIndex < Tool->GetNumHooks(); HookIndex++)
+		{
+			const FGrappleHook& Hook = Tool->GetHooks()[HookIndex];
+			Ar.Logf(TEXT("    hook %d: %s, desired length %.0f"), HookIndex,
+				Hook.IsAttached() ? TEXT("attached") : Hook.IsFlying() ? TEXT("flying") : TEXT("retracted"),
+				Hook.DesiredCableLength);
+		}
+	}
+}
+
+void UGrapplingHookManagerSubsystem::DumpRelevancy(FOutputDevice& Ar) const
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (!NetDriver || !NetDriver->IsServer())
+	{
+		Ar.Logf(TEXT("Grapple relevancy can only be inspected on server"));
+		return;
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		const APlayerController* Controller = Connection ? Connection->PlayerController : nullptr;
+		if (!Controller)
+		{
+			continue;
+		}
+		const APlayerState* PlayerState = Controller->PlayerState;
+		const AActor* ViewTarget = Connection->ViewTarget ? Connection->ViewTarget.Get() : Controller;
+		Ar.Logf(TEXT("%s:"), PlayerState ? *PlayerState->GetPlayerName() : *Controller->GetName());
+
+		for (TActorIterator<AGrappleProjectile> It(GetWorld()); It; ++It)
+		{
+			AGrappleProjectile* Projectile = *It;
+			if (Projectile->IsHidden())
+			{
+				continue;
+			}
+			const APawn* ProjectileInstigator = Projectile->GetInstigator();
+			const APlayerState* OwnerState = ProjectileInstigator ? ProjectileInstigator->GetPlayerState() : nullptr;
+			const bool bRelevant = Projectile->IsNetRelevantFor(Controller, ViewTarget, ViewTarget->GetActorLocation());
+			const bool bHasChannel = Connection->FindActorChannelRef(Projectile) != nullptr;
+			Ar.Logf(TEXT("  grapple of %s at %.0f m: %s%s"),
+				OwnerState ? *OwnerState->GetPlayerName() : TEXT("<no player>"),
+				FVector::Distance(ViewTarget->GetActorLocation(), Projectile->GetActorLocation()) / 100,
+				bHasChannel ? TEXT("receiving") : TEXT("not receiving"),
+				bRelevant ? TEXT("") : TEXT(" (not relevant)"));
+		}
+	}
+}
+
+void UGrapplingHookManagerSubsystem::SaveSwingRecordings(FOutputDevice& Ar) const
+{
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("GrappleSwings");
+	const FString Timestamp = FDateTime::Now().ToString();
+	int32 NumSaved = 0;
+	for (TActorIterator<AGrapplingHookTool> It(GetWorld()); It; ++It)
+	{
+		const AGrapplingHookTool* Tool = *It;
+		const AFGCharacterPlayer* Player = Tool->GetInstigatorCharacter();
+		const APlayerState* PlayerState = Player ? Player->GetPlayerState() : nullptr;
+		const FString PlayerName = FPaths::MakeValidFileName(PlayerState ? PlayerState->GetPlayerName() : Tool->GetName());
+		const FString FileName = Directory / FString::Printf(TEXT("%s_%s.agswing"), *PlayerName, *Timestamp);
+		if (Tool->SaveSwingRecording(FileName))
+		{
+			Ar.Logf(TEXT("Saved swing recording %s"), *FileName);
+			++NumSaved;
+		}
+	}
+	if (NumSaved == 0)
+	{
+		Ar.Logf(TEXT("No swings recorded; set AsgGrapple.SwingRecordFrames to amount of ticks to keep"));
+	}
+}
+
+TStatId UGrapplingHookManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGrapplingHookManagerSubsystem, STATGROUP_Tickables);
+}
+
+bool UGrapplingHookManagerSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
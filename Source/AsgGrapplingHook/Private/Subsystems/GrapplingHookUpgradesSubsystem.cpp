@@ -0,0 +1,69 @@
+﻿#include "Subsystems/GrapplingHookUpgradesSubsystem.h"
+
+#include "FGSchematicManager.h"
+
+namespace
+{
+	// Generations are unique across all worlds, so a value cached in one world can never be mistaken as valid in another.
+	uint32 GUpgradesGenerationCounter = 0;
+
+	uint32 NextUpgradesGeneration()
+	{
+		if (++GUpgradesGenerationCounter == 0)
+		{
+			// Zero is reserved for "not cacheable"
+			++GUpgradesGenerationCounter;
+		}
+		return GUpgradesGenerationCounter;
+	}
+}
+
+UGrapplingHookUpgradesSubsystem* UGrapplingHookUpgradesSubsystem::Get(const UWorld* World)
+{
+	return World ? World->GetSubsystem<UGrapplingHookUpgradesSubsystem>() : nullptr;
+}
+
+void UGrapplingHookUpgradesSubsystem::Deinitialize()
+{
+	if (AFGSchematicManager* Manager = SchematicManager.Get())
+	{
+		Manager->PurchasedSchematicDelegate.RemoveDynamic(this, &UGrapplingHookUpgradesSubsystem::OnSchematicPurchased);
+	}
+	SchematicManager.Reset();
+	Generation = 0;
+
+	Super::Deinitialize();
+}
+
+uint32 UGrapplingHookUpgradesSubsystem::GetGeneration()
+{
+	// Schematic manager is spawned by game state, so it may not exist yet when the first tool asks for its values
+	if (!SchematicManager.IsValid())
+	{
+		AFGSchematicManager* Manager = AFGSchematicManager::Get(GetWorld());
+		if (!Manager)
+		{
+			return 0;
+		}
+		SchematicManager = Manager;
+		Manager->PurchasedSchematicDelegate.AddUniqueDynamic(this, &UGrapplingHookUpgradesSubsystem::OnSchematicPurchased);
+		Invalidate();
+	}
+	return Generation;
+}
+
+void UGrapplingHookUpgradesSubsystem::Invalidate()
+{
+	Generation = NextUpgradesGeneration();
+	++Stats.Invalidations;
+}
+
+bool UGrapplingHookUpgradesSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGrapplingHookUpgradesSubsystem::OnSchematicPurchased(TSubclassOf<UFGSchematic> Schematic)
+{
+	Invalidate();
+}
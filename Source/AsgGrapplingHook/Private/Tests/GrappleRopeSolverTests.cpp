@@ -0,0 +1,90 @@
+﻿#include "Physics/GrappleRopeSolver.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GrappleRopeSolverTests
+{
+	constexpr float DeltaSeconds = 1.0f / 60;
+	const FVector Gravity(0, 0, -980);
+
+	// Rope length along its particles
+	float GetRopeLength(const FGrappleRopeSolver& Solver)
+	{
+		float Length = 0;
+		for (int32 Index = 1; Index < Solver.GetNumParticles(); ++Index)
+		{
+			Length += FVector::Distance(Solver.GetParticleLocation(Index - 1), Solver.GetParticleLocation(Index));
+		}
+		return Length;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrappleRopeSolverTest, "AsgGrapple.RopeSolver.Constraints",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGrappleRopeSolverTest::RunTest(const FString& Parameters)
+{
+	using namespace GrappleRopeSolverTests;
+	// Far from world origin, where rope is stored relative to its start
+	const FVector Start(200000, -150000, 5000);
+	const FVector End = Start + FVector(2000, 0, 0);
+
+	// Slack rope sags under gravity, keeps its length and stays pinned at both ends
+	FGrappleRopeSolver Slack;
+	Slack.Initialize(24, Start, End);
+	for (int32 Tick = 0; Tick < 600; ++Tick)
+	{
+		Slack.Step(DeltaSeconds, Start, End, 2500, 16, Gravity);
+	}
+	TestTrue(TEXT("Start is pinned"), Slack.GetParticleLocation(0).Equals(Start, 0.1));
+	TestTrue(TEXT("End is pinned"), Slack.GetParticleLocation(Slack.GetNumParticles() - 1).Equals(End, 0.1));
+	TestTrue(TEXT("Slack rope sags"), Slack.GetParticleLocation(Slack.GetNumParticles() / 2).Z < Start.Z - 100);
+	TestTrue(TEXT("Slack rope keeps its length"), FMath::IsNearlyEqual(GetRopeLength(Slack), 2500, 2500 * 0.1f));
+
+	// Rope shorter than distance between its ends is pulled straight
+	FGrappleRopeSolver Tense;
+	Tense.Initialize(24, Start, End);
+	for (int32 Tick = 0; Tick < 600; ++Tick)
+	{
+		Tense.Step(DeltaSeconds, Start, End, 1900, 16, Gravity);
+	}
+	TestTrue(TEXT("Tense rope stays straight"), Tense.GetParticleLocation(Tense.GetNumParticles() / 2).Z > Start.Z - 100);
+
+	// Moving ends drag the rope along instead of leaving particles behind
+	const FVector Offset(0, 5000, 0);
+	for (int32 Tick = 0; Tick < 600; ++Tick)
+	{
+		Tense.Step(DeltaSeconds, Start + Offset, End + Offset, 1900, 16, Gravity);
+	}
+	TestTrue(TEXT("Rope follows its ends"), Tense.GetParticleLocation(Tense.GetNumParticles() / 2).Y > Start.Y + Offset.Y - 100);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrappleRopeSolverBenchmark, "AsgGrapple.RopeSolver.Benchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGrappleRopeSolverBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace GrappleRopeSolverTests;
+	const FVector Start = FVector::ZeroVector;
+	const FVector End(3000, 0, 0);
+	for (const int32 NumParticles : {16, 64, 256})
+	{
+		FGrappleRopeSolver Solver;
+		Solver.Initialize(NumParticles, Start, End);
+		double TotalMilliseconds = 0;
+		constexpr int32 NumSteps = 1000;
+		for (int32 Tick = 0; Tick < NumSteps; ++Tick)
+		{
+			Solver.Step(DeltaSeconds, Start, End, 3500, 8, Gravity);
+			TotalMilliseconds += Solver.GetLastStepStats().StepMilliseconds;
+		}
+		AddInfo(FString::Printf(TEXT("%d particles, 8 iterations: %.2f us per step, %.0f particle iterations per ms"),
+			NumParticles, TotalMilliseconds * 1000 / NumSteps, NumParticles * 8 * NumSteps / FMath::Max(TotalMilliseconds, UE_SMALL_NUMBER)));
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,185 @@
+﻿#include "Physics/GrappleTensionSolver.h"
+
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GrappleTensionSolverTests
+{
+	constexpr int32 NumInputs = 256;
+	constexpr int32 BenchmarkRepeats = 64;
+	constexpr float DeltaSeconds = 1.0f / 60;
+	constexpr float FixedTimestep = 1.0f / 120;
+	constexpr int32 MaxSubsteps = 8;
+
+	// Fixed set of swings: one and two cables, slack and tense, in the air and walking
+	TArray<FGrappleTensionInput> MakeInputs()
+	{
+		FRandomStream Random(0x47524150);
+		TArray<FGrappleTensionInput> Inputs;
+		Inputs.Reserve(NumInputs);
+		for (int32 Index = 0; Index < NumInputs; ++Index)
+		{
+			FGrappleTensionInput& Input = Inputs.AddDefaulted_GetRef();
+			Input.CharacterLocation = Random.GetUnitVector() * Random.FRandRange(0, 5000);
+			Input.Velocity = Random.GetUnitVector() * Random.FRandRange(0, 3000);
+			Input.bWalking = Index % 4 == 0;
+			Input.FloorNormal = FVector::UpVector;
+			const int32 NumConstraints = Index % 3 == 0 ? 2 : 1;
+			for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints; ++ConstraintIndex)
+			{
+				FGrappleTensionConstraint& Constraint = Input.Constraints.AddDefaulted_GetRef();
+				Constraint.ForcePoint = Input.CharacterLocation + Random.GetUnitVector() * Random.FRandRange(500, 6000);
+				Constraint.CableLength = FVector::Distance(Constraint.ForcePoint, Input.CharacterLocation);
+				Constraint.DesiredCableLength = Constraint.CableLength * Random.FRandRange(0.8f, 1.1f);
+			}
+		}
+		return Inputs;
+	}
+
+	bool IsBitIdentical(const FGrappleTensionOutput& A, const FGrappleTensionOutput& B)
+	{
+		return FMemory::Memcmp(&A.Velocity, &B.Velocity, sizeof(FVector)) == 0
+			&& A.bTense == B.bTense && A.bTakeOff == B.bTakeOff;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrappleTensionSolverDeterminismTest, "AsgGrapple.TensionSolver.Determinism",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGrappleTensionSolverDeterminismTest::RunTest(const FString& Parameters)
+{
+	using namespace GrappleTensionSolverTests;
+	const TArray<FGrappleTensionInput> Inputs = MakeInputs();
+
+	// Same input must give bit-identical output, whichever order or thread solves it
+	for (int32 Index = 0; Index < Inputs.Num(); ++Index)
+	{
+		const FGrappleTensionOutput First = FGrappleTensionSolver::Step(Inputs[Index], DeltaSeconds);
+		const FGrappleTensionOutput Second = FGrappleTensionSolver::Step(Inputs[Index], DeltaSeconds);
+		if (!IsBitIdentical(First, Second))
+		{
+			AddError(FString::Printf(TEXT("Step is not deterministic for input %d"), Index));
+			return false;
+		}
+
+		float FirstAccumulator = 0;
+		float SecondAccumulator = 0;
+		const FGrappleTensionOutput FirstIntegrated = FGrappleTensionSolver::Integrate(Inputs[Index], DeltaSeconds, FixedTimestep, MaxSubsteps, FirstAccumulator);
+		const FGrappleTensionOutput SecondIntegrated = FGrappleTensionSolver::Integrate(Inputs[Index], DeltaSeconds, FixedTimestep, MaxSubsteps, SecondAccumulator);
+		if (!IsBitIdentical(FirstIntegrated, SecondIntegrated) || FirstAccumulator != SecondAccumulator)
+		{
+			AddError(FString::Printf(TEXT("Integrate is not deterministic for input %d"), Index));
+			return false;
+		}
+	}
+
+	// Batch solve must not differ from solving items one by one
+	TArray<FGrappleTensionBatchItem> Items;
+	for (const FGrappleTensionInput& Input : Inputs)
+	{
+		FGrappleTensionBatchItem& Item = Items.AddDefaulted_GetRef();
+		Item.Input = Input;
+		Item.DeltaSeconds = DeltaSeconds;
+		Item.TearingDistance = TNumericLimits<float>::Max();
+		Item.bFixedTimestep = false;
+	}
+	ParallelFor(Items.Num(), [&Items](const int32 Index)
+	{
+		FGrappleTensionSolver::Solve(Items[Index]);
+	});
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		TestTrue(FString::Printf(TEXT("Parallel solve of item %d matches Step"), Index),
+			IsBitIdentical(Items[Index].Output, FGrappleTensionSolver::Step(Inputs[Index], DeltaSeconds)));
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrappleTensionSolverBehaviorTest, "AsgGrapple.TensionSolver.Behavior",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGrappleTensionSolverBehaviorTest::RunTest(const FString& Parameters)
+{
+	using namespace GrappleTensionSolverTests;
+	FGrappleTensionInput Input;
+	Input.CharacterLocation = FVector::ZeroVector;
+	Input.Velocity = FVector(-1000, 0, 0);
+	FGrappleTensionConstraint& Constraint = Input.Constraints.AddDefaulted_GetRef();
+	Constraint.ForcePoint = FVector(1000, 0, 0);
+	Constraint.CableLength = 1000;
+
+	// Slack cable leaves velocity alone
+	Constraint.DesiredCableLength = 1200;
+	const FGrappleTensionOutput Slack = FGrappleTensionSolver::Step(Input, DeltaSeconds);
+	TestFalse(TEXT("Slack cable is not tense"), Slack.bTense);
+	TestEqual(TEXT("Slack cable keeps velocity"), Slack.Velocity, Input.Velocity);
+
+	// Tense cable cancels part of velocity away from force point and never adds velocity away from it
+	Constraint.DesiredCableLength = 1000;
+	const FGrappleTensionOutput Tense = FGrappleTensionSolver::Step(Input, DeltaSeconds);
+	TestTrue(TEXT("Tense cable is tense"), Tense.bTense);
+	TestTrue(TEXT("Tense cable slows character moving away"), Tense.Velocity.X > Input.Velocity.X && Tense.Velocity.X <= 0);
+
+	// Second cable on the opposite side holds character from the other direction
+	FGrappleTensionInput DualInput = Input;
+	FGrappleTensionConstraint& Opposite = DualInput.Constraints.AddDefaulted_GetRef();
+	Opposite.ForcePoint = FVector(-1000, 0, 0);
+	Opposite.CableLength = 1000;
+	Opposite.DesiredCableLength = 1000;
+	DualInput.Velocity = FVector(0, 0, -500);
+	const FGrappleTensionOutput Dual = FGrappleTensionSolver::Step(DualInput, DeltaSeconds);
+	TestTrue(TEXT("Perpendicular velocity is not affected by two opposite cables"), Dual.Velocity.Equals(DualInput.Velocity, 0.01));
+
+	// Fixed timestep carries time over instead of dropping it
+	float Accumulator = 0;
+	FGrappleTensionSolver::Integrate(Input, FixedTimestep * 1.5f, FixedTimestep, MaxSubsteps, Accumulator);
+	TestEqual(TEXT("Time left after full step stays in accumulator"), Accumulator, FixedTimestep * 0.5f);
+
+	// Frames shorter than fixed timestep still apply tension every frame
+	Accumulator = 0;
+	const FGrappleTensionOutput Short = FGrappleTensionSolver::Integrate(Input, FixedTimestep * 0.5f, FixedTimestep, MaxSubsteps, Accumulator);
+	TestTrue(TEXT("Short frame is tense"), Short.bTense);
+	TestEqual(TEXT("Short frame consumes its time"), Accumulator, 0.0f);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrappleTensionSolverBenchmark, "AsgGrapple.TensionSolver.Benchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGrappleTensionSolverBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace GrappleTensionSolverTests;
+	const TArray<FGrappleTensionInput> Inputs = MakeInputs();
+
+	// Sink keeps the optimizer from dropping the loop
+	double Sink = 0;
+	const double StepStart = FPlatformTime::Seconds();
+	for (int32 Repeat = 0; Repeat < BenchmarkRepeats; ++Repeat)
+	{
+		for (const FGrappleTensionInput& Input : Inputs)
+		{
+			Sink += FGrappleTensionSolver::Step(Input, DeltaSeconds).Velocity.X;
+		}
+	}
+	const double StepSeconds = FPlatformTime::Seconds() - StepStart;
+
+	const double IntegrateStart = FPlatformTime::Seconds();
+	for (int32 Repeat = 0; Repeat < BenchmarkRepeats; ++Repeat)
+	{
+		for (const FGrappleTensionInput& Input : Inputs)
+		{
+			float Accumulator = 0;
+			Sink += FGrappleTensionSolver::Integrate(Input, DeltaSeconds, FixedTimestep, MaxSubsteps, Accumulator).Velocity.X;
+		}
+	}
+	const double IntegrateSeconds = FPlatformTime::Seconds() - IntegrateStart;
+
+	const int32 NumCalls = BenchmarkRepeats * Inputs.Num();
+	AddInfo(FString::Printf(TEXT("Step: %.1f ns per call; Integrate (%.0f Hz frame, %.0f Hz substeps): %.1f ns per call (checksum %f)"),
+		StepSeconds * 1e9 / NumCalls, 1 / DeltaSeconds, 1 / FixedTimestep, IntegrateSeconds * 1e9 / NumCalls, Sink));
+	return true;
+}
+
+#endif
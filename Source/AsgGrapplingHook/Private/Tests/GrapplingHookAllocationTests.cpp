@@ -0,0 +1,119 @@
+﻿#include "Equipment/GrapplingHookTool.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GrapplingHookAllocationTests
+{
+	constexpr int32 NumShots = 100;
+
+	// Forwards to the allocator it replaces, counting allocations made by the thread that installed it
+	class FScopedAllocationCounter : public FMalloc
+	{
+	public:
+		FScopedAllocationCounter()
+			: Inner(GMalloc)
+			, ThreadId(FPlatformTLS::GetCurrentThreadId())
+		{
+			GMalloc = this;
+		}
+
+		virtual ~FScopedAllocationCounter() override
+		{
+			GMalloc = Inner;
+		}
+
+		int32 GetNumAllocations() const { return NumAllocations; }
+
+		virtual void* Malloc(const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(const SIZE_T Count, const uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(const bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				++NumAllocations;
+			}
+		}
+
+	private:
+		FMalloc* Inner;
+		uint32 ThreadId;
+		int32 NumAllocations = 0;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookSteadyShootingAllocationTest, "AsgGrapple.Allocations.SteadyShooting",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGrapplingHookSteadyShootingAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace GrapplingHookAllocationTests;
+	AGrapplingHookTool* Tool = GetMutableDefault<AGrapplingHookTool>();
+
+	// Pooled projectile shot again by the same tool keeps its impact binding
+	AGrappleProjectile::FGrappleProjectileImpactDelegate ImpactEvent;
+	AGrapplingHookTool::BindImpactEvent(ImpactEvent, Tool);
+	int32 NumAllocations;
+	{
+		const FScopedAllocationCounter Counter;
+		for (int32 Shot = 0; Shot < NumShots; ++Shot)
+		{
+			AGrapplingHookTool::BindImpactEvent(ImpactEvent, Tool);
+		}
+		NumAllocations = Counter.GetNumAllocations();
+	}
+	TestEqual(TEXT("Shots of the same tool allocate nothing"), NumAllocations, 0);
+	TestTrue(TEXT("Impact is routed to the shooting tool"), ImpactEvent.IsBoundToObject(Tool));
+
+	ImpactEvent.Unbind();
+
+	// Cable state size is measured with a writer whose buffer is allocated once
+	FNetBitWriter SizeWriter(nullptr, 256);
+	FGrappleCableState CableState;
+	{
+		const FScopedAllocationCounter Counter;
+		for (int32 Shot = 0; Shot < NumShots; ++Shot)
+		{
+			CableState.SetVelocity(FVector(Shot, -Shot, 2 * Shot));
+			SizeWriter.Reset();
+			bool bSuccess = true;
+			CableState.NetSerialize(SizeWriter, nullptr, bSuccess);
+		}
+		NumAllocations = Counter.GetNumAllocations();
+	}
+	TestEqual(TEXT("Measuring cable state allocates nothing"), NumAllocations, 0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,178 @@
+﻿#include "Subsystems/GrapplingHookManagerSubsystem.h"
+
+#include "AsgGrapplingHookSettings.h"
+#include "Algo/Count.h"
+#include "Equipment/GrappleCableState.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/CoreNet.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GrapplingHookBudgetTests
+{
+	// Amount of simultaneously swinging players the budgets are expected to hold for
+	constexpr int32 NumPlayers = 8;
+	constexpr int32 NumFrames = 600;
+	constexpr float DeltaSeconds = 1.0f / 60;
+	// Same as tool defaults
+	constexpr float FixedTimestep = 1.0f / 60;
+	constexpr int32 MaxSubsteps = 8;
+	constexpr float CableStateSendRate = 20;
+	constexpr float ReelSpeed = 150;
+	const FVector Gravity(0, 0, -980);
+
+	// Server side of a player hanging on a grapple, without the character: movement is integrated from solved velocity
+	struct FScriptedSwing
+	{
+		FVector Location = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+		FVector Anchor = FVector::ZeroVector;
+		float DesiredCableLength = 0;
+		float TimeAccumulator = 0;
+		FGrappleCableState PendingCableState;
+		FGrappleCableState CableState;
+		float LastCableStateSendTime = -1;
+	};
+
+	// Every player starts off to the side of their anchor, falls into a swing and reels in, every second one on two cables
+	TArray<FScriptedSwing> MakeSwings()
+	{
+		TArray<FScriptedSwing> Swings;
+		for (int32 Index = 0; Index < NumPlayers; ++Index)
+		{
+			FScriptedSwing& Swing = Swings.AddDefaulted_GetRef();
+			Swing.Anchor = FVector(Index * 10000, 0, 5000);
+			Swing.Location = Swing.Anchor + FVector(1500, 300 * (Index % 3), -1500);
+			Swing.DesiredCableLength = FVector::Distance(Swing.Anchor, Swing.Location);
+		}
+		return Swings;
+	}
+
+	void Gather(const TArray<FScriptedSwing>& Swings, TArray<FGrappleTensionBatchItem>& OutItems)
+	{
+		OutItems.Reset();
+		for (int32 Index = 0; Index < Swings.Num(); ++Index)
+		{
+			const FScriptedSwing& Swing = Swings[Index];
+			FGrappleTensionBatchItem& Item = OutItems.AddDefaulted_GetRef();
+			Item.Input.CharacterLocation = Swing.Location;
+			Item.Input.Velocity = Swing.Velocity + Gravity * DeltaSeconds;
+			const int32 NumConstraints = Index % 2 == 0 ? 1 : 2;
+			for (int32 ConstraintIndex = 0; ConstraintIndex < NumConstraints; ++ConstraintIndex)
+			{
+				FGrappleTensionConstraint& Constraint = Item.Input.Constraints.AddDefaulted_GetRef();
+				Constraint.ForcePoint = Swing.Anchor + FVector(0, ConstraintIndex * 800, 0);
+				Constraint.CableLength = FVector::Distance(Constraint.ForcePoint, Swing.Location);
+				Constraint.DesiredCableLength = Swing.DesiredCableLength;
+				Item.HookIndices.Add(ConstraintIndex);
+			}
+			Item.DeltaSeconds = DeltaSeconds;
+			Item.TearingDistance = TNumericLimits<float>::Max();
+			Item.FixedTimestep = FixedTimestep;
+			Item.MaxSubsteps = MaxSubsteps;
+			Item.TimeAccumulator = Swing.TimeAccumulator;
+		}
+	}
+
+	// Writes solved velocity back and sends cable state the way tool does; returns bytes sent
+	int32 WriteBack(const TArray<FGrappleTensionBatchItem>& Items, TArray<FScriptedSwing>& Swings, const float Now, FNetBitWriter& SizeWriter)
+	{
+		int32 Bytes = 0;
+		for (int32 Index = 0; Index < Swings.Num(); ++Index)
+		{
+			FScriptedSwing& Swing = Swings[Index];
+			const FGrappleTensionBatchItem& Item = Items[Index];
+			Swing.TimeAccumulator = Item.TimeAccumulator;
+			Swing.Velocity = Item.Output.Velocity;
+			Swing.Location += Swing.Velocity * DeltaSeconds;
+			Swing.DesiredCableLength = FMath::Max(Swing.DesiredCableLength - ReelSpeed * DeltaSeconds, 500.0f);
+
+			Swing.PendingCableState.ClearVelocity();
+			if (Item.Output.bTense)
+			{
+				Swing.PendingCableState.SetVelocity(Item.Output.Velocity);
+			}
+			if (Now - Swing.LastCableStateSendTime < 1.0f / CableStateSendRate
+				|| Swing.PendingCableState.HasSameContents(Swing.CableState))
+			{
+				continue;
+			}
+			Swing.LastCableStateSendTime = Now;
+			Swing.PendingCableState.SetSequence(static_cast<uint8>(Swing.CableState.GetSequence() + 1));
+			Swing.CableState = Swing.PendingCableState;
+
+			SizeWriter.Reset();
+			bool bSuccess = true;
+			Swing.CableState.NetSerialize(SizeWriter, nullptr, bSuccess);
+			Bytes += SizeWriter.GetNumBytes();
+		}
+		return Bytes;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookBudgetTest, "AsgGrapple.Budget.ScriptedSwings",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FGrapplingHookBudgetTest::RunTest(const FString& Parameters)
+{
+	using namespace GrapplingHookBudgetTests;
+	TArray<FScriptedSwing> Swings = MakeSwings();
+	TArray<FGrappleTensionBatchItem> Items;
+	FNetBitWriter SizeWriter(nullptr, 256);
+
+	FString Csv = TEXT("Frame,Time,BatchMs,TenseCables,CableStateBytes\n");
+	TArray<double> BatchMilliseconds;
+	BatchMilliseconds.Reserve(NumFrames);
+	int32 WindowBytes = 0;
+	float WindowStart = 0;
+	float PeakBytesPerSecond = 0;
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const float Now = Frame * DeltaSeconds;
+		const double BatchStart = FPlatformTime::Seconds();
+		Gather(Swings, Items);
+		UGrapplingHookManagerSubsystem::SolveBatch(Items);
+		const double BatchMs = (FPlatformTime::Seconds() - BatchStart) * 1000.0;
+		const int32 Bytes = WriteBack(Items, Swings, Now, SizeWriter);
+
+		BatchMilliseconds.Add(BatchMs);
+		WindowBytes += Bytes;
+		if (Now - WindowStart >= 1.0f)
+		{
+			PeakBytesPerSecond = FMath::Max(PeakBytesPerSecond, WindowBytes / (Now - WindowStart));
+			WindowStart = Now;
+			WindowBytes = 0;
+		}
+		const int32 NumTense = Algo::CountIf(Items, [](const FGrappleTensionBatchItem& Item) { return Item.Output.bTense; });
+		Csv.Appendf(TEXT("%d,%.4f,%.4f,%d,%d\n"), Frame, Now, BatchMs, NumTense, Bytes);
+	}
+
+	const FString CsvPath = FPaths::AutomationDir() / TEXT("AsgGrapple") / TEXT("ScriptedSwings.csv");
+	if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		AddInfo(FString::Printf(TEXT("Per frame timings written to %s"), *CsvPath));
+	}
+
+	// Single frames may stall on a busy machine; budget regression shows in most of them
+	BatchMilliseconds.Sort();
+	const double BatchMsP95 = BatchMilliseconds[BatchMilliseconds.Num() * 95 / 100];
+	AddInfo(FString::Printf(TEXT("%d players: tension batch %.3f ms (95th percentile), cable state traffic %.0f B/s (peak)"),
+		NumPlayers, BatchMsP95, PeakBytesPerSecond));
+
+	const UAsgGrapplingHookSettings* Settings = UAsgGrapplingHookSettings::Get();
+	if (Settings->TensionBatchBudgetMs > 0)
+	{
+		TestTrue(FString::Printf(TEXT("Tension batch %.3f ms fits budget %.3f ms"), BatchMsP95, Settings->TensionBatchBudgetMs),
+			BatchMsP95 <= Settings->TensionBatchBudgetMs);
+	}
+	if (Settings->CableStateBytesPerSecondBudget > 0)
+	{
+		TestTrue(FString::Printf(TEXT("Cable state traffic %.0f B/s fits budget %.0f B/s"), PeakBytesPerSecond, Settings->CableStateBytesPerSecondBudget),
+			PeakBytesPerSecond <= Settings->CableStateBytesPerSecondBudget);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,102 @@
+﻿#include "Equipment/GrapplingHookItemState.h"
+
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GrapplingHookItemStateTests
+{
+	// Saves state the way item state is saved: SaveGame properties only, as deltas against struct defaults
+	TArray<uint8> Save(FGrapplingHookItemState& State)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+		Ar.ArIsSaveGame = true;
+		const FGrapplingHookItemState Defaults;
+		FGrapplingHookItemState::StaticStruct()->SerializeItem(Ar, &State, &Defaults);
+		return Bytes;
+	}
+
+	FGrapplingHookItemState Load(const TArray<uint8>& Bytes)
+	{
+		FGrapplingHookItemState State;
+		FMemoryReader Reader(Bytes);
+		FObjectAndNameAsStringProxyArchive Ar(Reader, false);
+		Ar.ArIsSaveGame = true;
+		const FGrapplingHookItemState Defaults;
+		FGrapplingHookItemState::StaticStruct()->SerializeItem(Ar, &State, &Defaults);
+		return State;
+	}
+
+	FGrappleCableWrapPoint MakeWrapPoint(const FVector& Location, float LengthFromFirstPoint)
+	{
+		FGrappleCableWrapPoint WrapPoint;
+		WrapPoint.Location = Location;
+		WrapPoint.BendNormal = FVector::UpVector;
+		WrapPoint.LengthFromFirstPoint = LengthFromFirstPoint;
+		return WrapPoint;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGrapplingHookItemStateRoundTripTest, "AsgGrapple.ItemState.RoundTrip",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGrapplingHookItemStateRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace GrapplingHookItemStateTests;
+	FGrapplingHookItemState Saved;
+	Saved.Version = FGrapplingHookItemState::LatestVersion;
+	FGrapplingHookSavedHook& First = Saved.Hooks.AddDefaulted_GetRef();
+	First.HookIndex = 0;
+	First.AttachLocation = FVector(1000, 2000, 300);
+	First.DesiredCableLength = 1500;
+	First.WrapPoints.Add(MakeWrapPoint(FVector(800, 1500, 300), 0));
+	First.WrapPoints.Add(MakeWrapPoint(FVector(600, 1000, 250), 540));
+	FGrapplingHookSavedHook& Second = Saved.Hooks.AddDefaulted_GetRef();
+	Second.HookIndex = 1;
+	Second.AttachLocation = FVector(-1000, 0, 500);
+	Second.DesiredCableLength = 900;
+
+	FGrapplingHookItemState Loaded = Load(Save(Saved));
+	TestEqual(TEXT("Version survives save"), Loaded.Version, static_cast<int32>(FGrapplingHookItemState::LatestVersion));
+	TestTrue(TEXT("Loaded state is restorable"), Loaded.IsRestorable());
+	if (!TestEqual(TEXT("Every hook is loaded"), Loaded.Hooks.Num(), Saved.Hooks.Num()))
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < Saved.Hooks.Num(); ++Index)
+	{
+		const FGrapplingHookSavedHook& Expected = Saved.Hooks[Index];
+		const FGrapplingHookSavedHook& Actual = Loaded.Hooks[Index];
+		TestEqual(TEXT("Hook index"), Actual.HookIndex, Expected.HookIndex);
+		TestEqual(TEXT("Attach location"), Actual.AttachLocation, Expected.AttachLocation);
+		TestEqual(TEXT("Desired cable length"), Actual.DesiredCableLength, Expected.DesiredCableLength);
+		if (!TestEqual(TEXT("Wrap point count"), Actual.WrapPoints.Num(), Expected.WrapPoints.Num()))
+		{
+			continue;
+		}
+		for (int32 PointIndex = 0; PointIndex < Expected.WrapPoints.Num(); ++PointIndex)
+		{
+			TestEqual(TEXT("Wrap point location"), Actual.WrapPoints[PointIndex].Location, Expected.WrapPoints[PointIndex].Location);
+			TestEqual(TEXT("Wrap point bend normal"), Actual.WrapPoints[PointIndex].BendNormal, Expected.WrapPoints[PointIndex].BendNormal);
+			TestEqual(TEXT("Wrap point length"), Actual.WrapPoints[PointIndex].LengthFromFirstPoint, Expected.WrapPoints[PointIndex].LengthFromFirstPoint);
+		}
+	}
+
+	// Tool without attached hooks saves nothing worth restoring
+	FGrapplingHookItemState Empty;
+	Empty.Version = FGrapplingHookItemState::LatestVersion;
+	TestFalse(TEXT("Empty state is not restorable"), Load(Save(Empty)).IsRestorable());
+
+	// Save from a newer version of the mod is not understood
+	FGrapplingHookItemState Future = Saved;
+	Future.Version = FGrapplingHookItemState::LatestVersion + 1;
+	TestFalse(TEXT("Newer save is not restorable"), Load(Save(Future)).IsRestorable());
+	return true;
+}
+
+#endif
@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+ASGGRAPPLINGHOOK_API DECLARE_LOG_CATEGORY_EXTERN(LogAsgGrapple, Log, All);
+
 class FAsgGrapplingHookModule : public IModuleInterface
 {
 public:
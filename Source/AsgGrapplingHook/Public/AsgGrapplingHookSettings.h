@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AsgGrapplingHookSettings.generated.h"
+
+// Global (not per tool) settings of grappling hook mod.
+UCLASS(Config=Game, DefaultConfig, meta=(DisplayName="Grappling Hook"))
+class ASGGRAPPLINGHOOK_API UAsgGrapplingHookSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	static const UAsgGrapplingHookSettings* Get() { return GetDefault<UAsgGrapplingHookSettings>(); }
+
+public:
+	// How often cable LOD tiers are re-evaluated, in seconds.
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=0))
+	float CableLODUpdateInterval = 0.25f;
+	// Cables not rendered for this long (seconds) stop simulating.
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=0))
+	float CableLODNotRenderedTime = 0.5f;
+	// Distance from viewer at which cables switch to reduced simulation.
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=0))
+	float CableLODReducedDistance = 3000;
+	// Distance from viewer at which cables become a straight line.
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=0))
+	float CableLODStraightDistance = 10000;
+	// Distance a cable has to move back over a tier boundary before it's promoted to a more detailed tier again.
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=0))
+	float CableLODHysteresis = 500;
+	// Cable segments and solver iterations of reduced tier.
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=1))
+	int32 CableLODReducedNumSegments = 4;
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=1))
+	int32 CableLODReducedSolverIterations = 1;
+	// Maximum amount of cables simulated at full detail / reduced detail. Farthest cables over budget are moved to the next tier.
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=0))
+	int32 CableLODMaxFullCables = 4;
+	UPROPERTY(Config, EditAnywhere, Category="Cable LOD", meta=(ClampMin=0))
+	int32 CableLODMaxReducedCables = 8;
+
+	// Grapple projectiles (with their cables) farther than this from both projectile and its instigator are not
+	// replicated to a client. Own grapple is always relevant.
+	UPROPERTY(Config, EditAnywhere, Category="Network", meta=(ClampMin=0))
+	float GrappleNetCullDistance = 15000;
+	// Farther than this from viewer (but within cull distance), other players' grapples are only replicated while their
+	// cable is within GrappleNetViewConeHalfAngle of where the viewer looks (0 - view direction is ignored).
+	UPROPERTY(Config, EditAnywhere, Category="Network", meta=(ClampMin=0))
+	float GrappleNetViewConeDistance = 4000;
+	// Angle between view direction and cable, in degrees, within which distant grapples stay relevant.
+	UPROPERTY(Config, EditAnywhere, Category="Network", meta=(ClampMin=0, ClampMax=180))
+	float GrappleNetViewConeHalfAngle = 70;
+	// Net priority multiplier of own grapple projectile relative to other players' ones.
+	UPROPERTY(Config, EditAnywhere, Category="Network", meta=(ClampMin=0))
+	float OwnGrappleNetPriorityScale = 2;
+
+	// Shots of a single player closer in time than this (seconds) are dropped by server, whichever hook they come from.
+	UPROPERTY(Config, EditAnywhere, Category="Validation", meta=(ClampMin=0))
+	float ShootMinInterval = 0.1f;
+	// How far from server's character location client's shooting source may be.
+	UPROPERTY(Config, EditAnywhere, Category="Validation", meta=(ClampMin=0))
+	float ShootSourceTolerance = 300;
+	// Additional shooting source tolerance: character speed times this (seconds), covering movement during client's latency.
+	UPROPERTY(Config, EditAnywhere, Category="Validation", meta=(ClampMin=0))
+	float ShootSourceLatencyAllowance = 0.3f;
+
+	// Server time per frame allowed for simulating all attached grapples, in milliseconds (0 - unlimited).
+	UPROPERTY(Config, EditAnywhere, Category="Performance Budgets", meta=(ClampMin=0))
+	float TensionBatchBudgetMs = 0.5f;
+	// Cable state traffic of all tools in the world allowed per second, in bytes (0 - unlimited).
+	UPROPERTY(Config, EditAnywhere, Category="Performance Budgets", meta=(ClampMin=0))
+	float CableStateBytesPerSecondBudget = 4096;
+	// Budget overrun warnings are logged at most this often, in seconds.
+	UPROPERTY(Config, EditAnywhere, Category="Performance Budgets", meta=(ClampMin=0))
+	float BudgetWarningInterval = 10;
+};
@@ -0,0 +1,34 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// Use "stat AsgGrapple" in game to see these, and "-trace=cpu,AsgGrapple" to get grapple scopes in Insights.
+DECLARE_STATS_GROUP(TEXT("AsgGrapple"), STATGROUP_AsgGrapple, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Server Tick Grapple"), STAT_AsgGrapple_ServerTick, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Client Tick Grapple"), STAT_AsgGrapple_ClientTick, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tension Force"), STAT_AsgGrapple_TensionForce, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tension Batch"), STAT_AsgGrapple_TensionBatch, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pull Impulses"), STAT_AsgGrapple_PullImpulses, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Upgrade Value"), STAT_AsgGrapple_UpgradeValue, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cable Path Trace"), STAT_AsgGrapple_CablePathTrace, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Crosshair Trace"), STAT_AsgGrapple_CrosshairTrace, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Send Cable State"), STAT_AsgGrapple_SendCableState, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Cables"), STAT_AsgGrapple_ActiveCables, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Attached Cables"), STAT_AsgGrapple_AttachedCables, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pulled Bodies"), STAT_AsgGrapple_PulledBodies, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rejected RPCs"), STAT_AsgGrapple_RejectedRpcs, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("RPCs/sec"), STAT_AsgGrapple_RpcsPerSecond, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Cable State Updates/sec"), STAT_AsgGrapple_CableStateUpdatesPerSecond, STATGROUP_AsgGrapple, ASGGRAPPLINGHOOK_API);
+
+// Per-frame timings and counters captured by "csvprofile start" (or -csvCaptureFrames=N), e.g. on a -nullrhi server.
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(ASGGRAPPLINGHOOK_API, AsgGrapple);
+
+UE_TRACE_CHANNEL_EXTERN(AsgGrappleChannel, ASGGRAPPLINGHOOK_API);
+
+// Insights-only scope for code that runs too often or off game thread to be worth a stat (e.g. per batch item).
+#define ASG_GRAPPLE_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, AsgGrappleChannel)
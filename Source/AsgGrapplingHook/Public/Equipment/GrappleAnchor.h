@@ -0,0 +1,73 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "GrappleAnchor.generated.h"
+
+class USceneComponent;
+struct FBodyInstance;
+
+// Point grapple is hooked to, stored relative to the hit component (its bone or instance, if any), so the grapple
+// follows moving targets. Replicated once per attach as component reference and local offset; every machine resolves
+// world location from the component transform by itself, so nothing about the anchor is replicated while target moves.
+USTRUCT(BlueprintType)
+struct ASGGRAPPLINGHOOK_API FGrappleAnchor
+{
+	GENERATED_BODY()
+
+public:
+	void Reset();
+	// Anchors to hit point, relative to hit component. Hits on abstract instances are resolved to their buildable
+	// without converting the instance to an actor.
+	void SetFromHit(const FHitResult& HitResult);
+	// Anchors to given world location, relative to given component (may be null to anchor in world space).
+	void SetFromComponent(USceneComponent* InComponent, const FVector& Location);
+
+	bool IsSet() const { return bSet; }
+	// Whether anchors describe the same attachment (compares replicated state only).
+	bool operator==(const FGrappleAnchor& Other) const;
+	// Whether thing grapple was hooked to doesn't exist anymore (e.g. buildable was dismantled).
+	bool IsLost() const;
+
+	// Returns current world location of the anchor. Falls back to location at attach time if component can't be resolved
+	// on this machine (e.g. it's not net addressable).
+	FVector GetWorldLocation() const;
+
+	// Whether anchor was on a physics simulating body at attach time, so tension should move the body rather than player.
+	bool IsSimulatingPhysics() const { return bSimulatingPhysics; }
+	// Returns body the anchor is on (bone's body for skeletal meshes), or null if anchor is not on a primitive component.
+	FBodyInstance* GetBodyInstance() const;
+
+	USceneComponent* GetComponent() const { return Component.Get(); }
+	FName GetBoneName() const { return BoneName; }
+	// Actor owning hit geometry: buildable behind abstract instance, or owner of hit component. Server only.
+	AActor* GetOwnerActor() const { return OwnerActor.Get(); }
+
+private:
+	// Returns transform of the anchor's space (bone, instance or component itself).
+	FTransform GetAnchorSpaceTransform(const USceneComponent* AnchorComponent) const;
+
+private:
+	UPROPERTY()
+	TWeakObjectPtr<USceneComponent> Component;
+	UPROPERTY()
+	FName BoneName;
+	// Instance of instanced static mesh component, or INDEX_NONE.
+	UPROPERTY()
+	int32 InstanceIndex = INDEX_NONE;
+	// Anchor location in space of component (bone/instance).
+	UPROPERTY()
+	FVector_NetQuantize10 LocalOffset = FVector::ZeroVector;
+	// World location at attach time.
+	UPROPERTY()
+	FVector_NetQuantize10 AttachLocation = FVector::ZeroVector;
+	UPROPERTY()
+	bool bRelative = false;
+	UPROPERTY()
+	bool bSet = false;
+	UPROPERTY()
+	bool bSimulatingPhysics = false;
+
+	UPROPERTY(NotReplicated)
+	TWeakObjectPtr<AActor> OwnerActor;
+};
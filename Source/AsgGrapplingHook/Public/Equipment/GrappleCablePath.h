@@ -0,0 +1,76 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GrappleCablePath.generated.h"
+
+struct FCollisionQueryParams;
+
+// Point at which cable bends around some geometry.
+USTRUCT(BlueprintType)
+struct FGrappleCableWrapPoint
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, SaveGame)
+	FVector Location = FVector::ZeroVector;
+	// Normal of the plane in which cable bends around this point. Cable unwinds once it bends to the opposite side.
+	UPROPERTY(BlueprintReadOnly, SaveGame)
+	FVector BendNormal = FVector::ZeroVector;
+	// Length of cable between the first wrap point and this one.
+	UPROPERTY(BlueprintReadOnly, SaveGame)
+	float LengthFromFirstPoint = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FGrappleCableWrapSettings
+{
+	GENERATED_BODY()
+
+public:
+	// Radius of the sweep used to detect geometry between player and the last cable point.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float TraceRadius = 5;
+	// How far from the hit surface wrap point is placed, so the next sweep never starts inside geometry.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SurfaceOffset = 10;
+	// Wrap points closer than this to the previous cable point are not added.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float MinSegmentLength = 30;
+	// Cable will not wrap around anything else once this amount of wrap points is reached.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 MaxWrapPoints = 16;
+};
+
+// Cable geometry between grapple anchor and the tool, as an ordered list of points the cable is wrapped around.
+// Updated incrementally: every update sweeps only the free segment (tool to the last cable point) and checks only
+// the last wrap point for unwinding, so per-tick cost does not grow with the amount of cable turns.
+USTRUCT(BlueprintType)
+struct FGrappleCablePath
+{
+	GENERATED_BODY()
+
+public:
+	void Reset();
+	// Replaces path with previously saved wrap points.
+	void Restore(const TArray<FGrappleCableWrapPoint>& SavedWrapPoints);
+
+	// Adds wrap point if free segment hit something, removes last wrap points if cable unwound around them.
+	void Update(const UWorld* World, const FVector& SourceLocation, const FVector& AnchorLocation,
+		const FCollisionQueryParams& QueryParams, const FGrappleCableWrapSettings& Settings);
+
+	// Returns the point closest to the tool at which the cable is held (last wrap point or anchor itself).
+	FVector GetForcePoint(const FVector& AnchorLocation) const;
+	// Returns the point closest to the anchor towards which the anchor is pulled (first wrap point or the tool itself).
+	FVector GetAnchorPullPoint(const FVector& SourceLocation) const;
+	// Returns length of cable along all its turns.
+	float GetLength(const FVector& SourceLocation, const FVector& AnchorLocation) const;
+
+	const TArray<FGrappleCableWrapPoint>& GetWrapPoints() const { return WrapPoints; }
+	bool HasWrapPoints() const { return WrapPoints.Num() > 0; }
+
+private:
+	// Ordered from anchor towards the tool.
+	UPROPERTY(SaveGame)
+	TArray<FGrappleCableWrapPoint> WrapPoints;
+};
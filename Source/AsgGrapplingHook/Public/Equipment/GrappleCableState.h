@@ -0,0 +1,61 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "GrappleCableState.generated.h"
+
+// Cable state replicated from server to owning client. Bit-packed by custom net serializer: velocity is sent with
+// 0.1 precision and only while a cable is tense. Visual cable lengths are derived from replicated desired lengths.
+USTRUCT()
+struct ASGGRAPPLINGHOOK_API FGrappleCableState
+{
+	GENERATED_BODY()
+
+public:
+	void SetVelocity(const FVector& NewVelocity);
+	void ClearVelocity();
+	bool HasVelocity() const { return bHasVelocity; }
+	const FVector& GetVelocity() const { return Velocity; }
+
+	uint8 GetSequence() const { return Sequence; }
+	void SetSequence(const uint8 NewSequence) { Sequence = NewSequence; }
+
+	// Whether states are equal ignoring sequence number.
+	bool HasSameContents(const FGrappleCableState& Other) const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+	bool operator==(const FGrappleCableState& Other) const { return Sequence == Other.Sequence && HasSameContents(Other); }
+
+private:
+	// Velocity of tool's instigator after tension was applied; already quantized, so server and clients work with the same value.
+	FVector Velocity = FVector::ZeroVector;
+	bool bHasVelocity = false;
+
+	// Increments every time state with different contents is sent.
+	uint8 Sequence = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FGrappleCableState> : TStructOpsTypeTraitsBase2<FGrappleCableState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+// Outgoing cable state traffic of a single tool.
+USTRUCT(BlueprintType)
+struct FGrappleCableStateNetStats
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly)
+	int32 StatesSent = 0;
+	UPROPERTY(BlueprintReadOnly)
+	int64 BytesSent = 0;
+	// Bytes sent during the last full second.
+	UPROPERTY(BlueprintReadOnly)
+	float BytesPerSecond = 0;
+};
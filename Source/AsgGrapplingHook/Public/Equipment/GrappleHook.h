@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Equipment/GrappleAnchor.h"
+#include "Equipment/GrappleCablePath.h"
+#include "GrappleHook.generated.h"
+
+class AGrappleProjectile;
+
+// State of a single hook of grappling hook tool. Tool keeps all its hooks in one array, so it does the same for every
+// hook in plain loops. Properties are replicated to everyone; the rest is local bookkeeping of the machine simulating
+// or steering the hook.
+USTRUCT()
+struct ASGGRAPPLINGHOOK_API FGrappleHook
+{
+	GENERATED_BODY()
+
+public:
+	bool IsFlying() const { return Projectile && !bAttached; }
+	bool IsAttached() const { return Projectile && bAttached; }
+	// Whether owning client has shot the hook, but its projectile has not replicated yet.
+	bool IsAwaitingShot() const { return !Projectile && !bRetracted; }
+
+public:
+	// Projectile shot for this hook.
+	UPROPERTY()
+	TObjectPtr<AGrappleProjectile> Projectile = nullptr;
+	// Where hook is attached, relative to hit component. Only changes when hook attaches.
+	UPROPERTY()
+	FGrappleAnchor Anchor;
+	// Desired length is length at which tension force will be applied through this hook's cable.
+	// When it is larger than actual length, tension is not applied.
+	// When it is smaller than actual length, additional pulling force is applied.
+	UPROPERTY()
+	float DesiredCableLength = 0;
+	// Whether projectile is sticked to something.
+	UPROPERTY()
+	bool bAttached = false;
+
+	// Turns of attached cable around geometry. Maintained wherever tension is simulated.
+	FGrappleCablePath CablePath;
+	// Projectile settled at anchor on this machine, to be released once anchor or projectile changes.
+	TWeakObjectPtr<AGrappleProjectile> SettledProjectile;
+	// Local flag indicating whether projectile should be located inside the tool or not.
+	bool bRetracted = true;
+	// Time not yet simulated by fixed timestep tension of body pulled by this hook.
+	float TensionTimeAccumulator = 0;
+	// Owning client time of the last shot of this hook sent to server.
+	float ClientShootTime = -1;
+
+	// Stacked length control inputs of owning client; processed and zeroed every tick.
+	float CableLengthControlQuery = 0;
+	// Desired cable length owning client is steering towards; sent to server as absolute value.
+	float ClientTargetCableLength = 0;
+	// Whether ClientTargetCableLength has changed since it was sent last time.
+	bool bCableLengthInputDirty = false;
+	// How many more times last target is resent after input has stopped (protects against losing the final update).
+	int32 CableLengthInputResends = 0;
+	// Sequence number of the last length update sent by owning client.
+	uint16 CableLengthInputSequence = 0;
+	// Sequence number of the last length update accepted by server.
+	uint16 AcceptedCableLengthInputSequence = 0;
+	bool bReceivedCableLengthInput = false;
+};
@@ -0,0 +1,34 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+// Tension state predicted by owning client at a certain moment.
+struct FGrapplePredictionFrame
+{
+	// World time at which the frame was simulated.
+	float Time = 0;
+	FVector Velocity = FVector::ZeroVector;
+};
+
+// Fixed-size ring buffer of client-predicted tension states, ordered by time they were simulated at.
+struct ASGGRAPPLINGHOOK_API FGrapplePredictionHistory
+{
+public:
+	static constexpr int32 Capacity = 64;
+
+	void Reset();
+
+	// Stores new frame (overwriting the oldest one if buffer is full).
+	void Record(float Time, const FVector& Velocity);
+
+	// Returns frame simulated closest to given time, if there are any.
+	const FGrapplePredictionFrame* FindClosestToTime(float Time) const;
+
+	bool IsEmpty() const { return Num == 0; }
+
+private:
+	FGrapplePredictionFrame Frames[Capacity];
+	// Index at which next frame will be written.
+	int32 Head = 0;
+	int32 Num = 0;
+};
@@ -0,0 +1,64 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "WorldCollision.h"
+
+// Initial state of a grapple shot, as server will compute it (see UGrapplingHookRCO::ServerShootGrapple).
+struct FGrappleTrajectoryParams
+{
+	// Point cable length is measured from (tool's shooting source).
+	FVector Origin = FVector::ZeroVector;
+	// Point projectile is spawned at.
+	FVector Start = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	float GravityZ = 0;
+	// Shot is retracted once projectile gets farther than this from Origin.
+	float MaxDistance = 0;
+	// Simulation time of one traced segment.
+	float TimeStep = 0.1f;
+	// Projectiles flying longer than this are considered to never hit anything.
+	float MaxTime = 3;
+};
+
+// Predicts where a grapple shot lands by tracing its ballistic path segment by segment. Work is amortized across frames:
+// every Tick issues async traces for the next few segments only, and the path is finished once one of them hits
+// something, the projectile gets out of cable's reach or runs out of time.
+class ASGGRAPPLINGHOOK_API FGrappleTrajectoryPredictor
+{
+public:
+	// Starts predicting new path. Results of traces issued for previous path are ignored.
+	void Start(const FGrappleTrajectoryParams& InParams);
+
+	// Issues traces for up to SegmentsPerTick next segments, unless previous ones are still in flight.
+	void Tick(UWorld* World, FName ProfileName, const FCollisionQueryParams& QueryParams, const FTraceDelegate* Delegate, int32 SegmentsPerTick);
+	// Should be called with every completed trace issued by Tick. Returns true if this completed the path.
+	bool OnSegmentTraceCompleted(const FTraceDatum& TraceDatum);
+
+	bool IsStarted() const { return Points.Num() > 0; }
+	bool IsComplete() const { return bComplete; }
+	// Whether completed path ends with a hit within cable's reach.
+	bool IsReachable() const { return bComplete && bReachable; }
+	// Points of the path traced so far; the last one is the hit point once path completes as reachable.
+	const TArray<FVector>& GetPoints() const { return Points; }
+
+private:
+	FVector GetLocationAtTime(float Time) const;
+
+private:
+	FGrappleTrajectoryParams Params;
+	TArray<FVector> Points;
+
+	// Identifies traces of current path (stored in trace's user data with segment index).
+	uint16 Generation = 0;
+	int32 NumSegmentsTraced = 0;
+	int32 NumPendingTraces = 0;
+	// Whether the last issued segment reaches maximum distance or time.
+	bool bLastBatchReachesEnd = false;
+
+	// Earliest hit among segments of the batch in flight.
+	int32 FirstHitSegment = INDEX_NONE;
+	FVector FirstHitLocation = FVector::ZeroVector;
+
+	bool bComplete = false;
+	bool bReachable = false;
+};
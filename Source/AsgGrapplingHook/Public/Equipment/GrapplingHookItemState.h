@@ -0,0 +1,60 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Equipment/GrappleCablePath.h"
+#include "GrapplingHookItemState.generated.h"
+
+// Attached hook saved with the tool's inventory item.
+USTRUCT(BlueprintType)
+struct ASGGRAPPLINGHOOK_API FGrapplingHookSavedHook
+{
+	GENERATED_BODY()
+
+public:
+	bool IsRestorable() const { return DesiredCableLength > 0; }
+
+public:
+	// Index of the hook in tool's hooks.
+	UPROPERTY(SaveGame)
+	int32 HookIndex = 0;
+	// World location of grapple projectile.
+	UPROPERTY(SaveGame)
+	FVector AttachLocation = FVector::ZeroVector;
+	// Actor grapple was attached to, if any; projectile follows it after load.
+	UPROPERTY(SaveGame)
+	TSoftObjectPtr<AActor> AnchorActor;
+	UPROPERTY(SaveGame)
+	float DesiredCableLength = 0;
+	// Ordered from anchor towards the tool.
+	UPROPERTY(SaveGame)
+	TArray<FGrappleCableWrapPoint> WrapPoints;
+};
+
+// Grapple state saved with the tool's inventory item, so player keeps hanging on the cable after save is loaded.
+// Only attached hooks are saved; a flying shot is short-lived and is simply lost.
+USTRUCT(BlueprintType)
+struct ASGGRAPPLINGHOOK_API FGrapplingHookItemState
+{
+	GENERATED_BODY()
+
+public:
+	enum EVersion : int32
+	{
+		InitialVersion = 1,
+
+		// -----<new versions can be added above this line>-----
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	// Whether state was saved by a compatible version of the mod and describes at least one attached hook.
+	bool IsRestorable() const;
+
+public:
+	// Set explicitly when saving, so it differs from the default and is always written; zero means nothing was saved.
+	UPROPERTY(SaveGame)
+	int32 Version = 0;
+
+	UPROPERTY(SaveGame)
+	TArray<FGrapplingHookSavedHook> Hooks;
+};
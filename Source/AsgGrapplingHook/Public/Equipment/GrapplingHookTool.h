@@ -4,6 +4,16 @@
 #include "FGRemoteCallObject.h"
 #include "Equipment/FGWeapon.h"
 #include "Input/FGBoundMappingContextHandle.h"
+#include "WorldCollision.h"
+#include "UObject/CoreNet.h"
+#include "Equipment/GrappleAnchor.h"
+#include "Equipment/GrappleCablePath.h"
+#include "Equipment/GrappleCableState.h"
+#include "Equipment/GrappleHook.h"
+#include "Equipment/GrapplePrediction.h"
+#include "Equipment/GrapplingHookItemState.h"
+#include "Equipment/GrappleTrajectoryPredictor.h"
+#include "Physics/GrappleSwingRecording.h"
 #include "Projectiles/GrappleProjectile.h"
 #include "GrapplingHookTool.generated.h"
 
@@ -13,6 +23,10 @@ class UFGInputMappingContext;
 class AFGPlayerController;
 class UFGEnhancedInputComponent;
 class AFGProjectile;
+struct FGrappleTensionBatchItem;
+struct FGrappleTensionInput;
+struct FGrappleTensionOutput;
+struct FGrapplePullImpulse;
 
 UCLASS()
 class ASGGRAPPLINGHOOK_API UGrapplingHookRCO : public UFGRemoteCallObject
@@ -20,21 +34,37 @@ class ASGGRAPPLINGHOOK_API UGrapplingHookRCO : public UFGRemoteCallObject
 	GENERATED_BODY()
 
 public:
+	// Validation only rejects malformed input (and disconnects its sender); plausibility of the shot and rate limiting
+	// are checked by implementation, which drops suspicious shots without kicking anyone.
+	UFUNCTION(Server, Reliable, WithValidation)
+	void ServerShootGrapple(AGrapplingHookTool* Tool, uint8 HookIndex, const FVector& ShootingSourceLocation, const FVector& PlayerAimDirection);
 	UFUNCTION(Server, Reliable)
-	void ServerShootGrapple(AGrapplingHookTool* Tool, const FVector& ShootingSourceLocation, const FVector& PlayerAimDirection);
-	UFUNCTION(Server, Reliable)
-	void ServerRetractGrapple(AGrapplingHookTool* Tool);
+	void ServerRetractGrapple(AGrapplingHookTool* Tool, uint8 HookIndex);
 	
-	UFUNCTION(Server, Reliable)
-	void ServerProcessDesiredCableLengthQueries(AGrapplingHookTool* Tool, float QueriedChange, float DeltaSeconds);
+	// Sets absolute desired cable length requested by client. Sent unreliably at limited rate; every update supersedes
+	// previous ones, so lost or reordered updates are harmless (older sequence numbers are ignored).
+	UFUNCTION(Server, Unreliable)
+	void ServerSetDesiredCableLength(AGrapplingHookTool* Tool, uint8 HookIndex, uint16 Sequence, float TargetLength);
 
 private:
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+	// Counts received call in traffic stats (see UGrapplingHookManagerSubsystem::DumpStats).
+	void RecordRpc() const;
+	// Counts call dropped by validation, logging why.
+	void RecordRejectedRpc(const TCHAR* Reason) const;
+	// Whether tool is held by the player this RCO belongs to.
+	bool IsToolOwnedByCaller(const AGrapplingHookTool* Tool) const;
+	// Whether tool has hook with given index.
+	static bool IsValidHook(const AGrapplingHookTool* Tool, uint8 HookIndex);
+
 private:
 	// At least one property should be replicated in order for RCO to work.
 	UPROPERTY(Replicated)
 	bool bDummy = true;
+
+	// Server time of the last accepted shot of this player, whichever tool and hook it came from.
+	float LastShootTime = -1;
 };
 
 USTRUCT(BlueprintType)
@@ -43,14 +73,63 @@ struct FGrapplingHookUpgradesChain
 	GENERATED_BODY()
 
 public:
+	// Returns value of the last purchased upgrade in chain. Resolved value is cached until next schematic purchase in the world.
 	float GetActiveValue(const UObject* Context) const;
 	float GetActiveValue(UWorld* Context) const;
+
+private:
+	// Walks the whole upgrades chain querying schematic manager.
+	float ResolveActiveValue(UWorld* Context) const;
 	
 public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float BaseValue = 0;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TMap<TSubclassOf<UFGSchematic>, float> Upgrades;
+
+private:
+	// Upgrades generation (see UGrapplingHookUpgradesSubsystem) under which CachedValue was resolved; zero if nothing is cached.
+	mutable uint32 CachedGeneration = 0;
+	mutable float CachedValue = 0;
+};
+
+// What grapple tool's actor tick is currently scheduled for on this machine.
+UENUM(BlueprintType)
+enum class EGrapplingHookTickState : uint8
+{
+	// Nothing to do; actor tick is disabled.
+	Idle,
+	// Owning client aims with grapple retracted; only crosshair highlight is updated.
+	Crosshair,
+	// Projectile is flying towards its target.
+	Flying,
+	// Grapple is attached; owning client processes length input and prediction (server simulation is batched by manager).
+	Attached
+};
+
+// What tension of attached grapple acts on.
+UENUM(BlueprintType)
+enum class EGrapplingHookPullMode : uint8
+{
+	// Instigator is pulled towards grapple point.
+	Self,
+	// Physics body grapple is hooked to is pulled towards instigator.
+	Object
+};
+
+// Cable length input traffic of a single tool on owning client.
+USTRUCT(BlueprintType)
+struct FGrappleCableLengthInputStats
+{
+	GENERATED_BODY()
+
+public:
+	// Length updates actually sent to server.
+	UPROPERTY(BlueprintReadOnly)
+	int32 RpcsSent = 0;
+	// Ticks with length input that were coalesced into a later update instead of being sent.
+	UPROPERTY(BlueprintReadOnly)
+	int32 RpcsSuppressed = 0;
 };
 
 UCLASS(Abstract)
@@ -63,8 +142,13 @@ class ASGGRAPPLINGHOOK_API AGrapplingHookTool : public AFGEquipment
 public:
 	AGrapplingHookTool();
 	
+	//~ Begin UObject interface
+	virtual void PostInitProperties() override;
+	//~ End UObject interface
+
 	//~ Begin AActor interface
 	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	//~ End AActor interface
 
@@ -78,42 +162,142 @@ public:
 	virtual void AddEquipmentActionBindings() override;
 	//~ End AFGEquipment interface
 
+	// Retracts all hooks.
 	void RetractGrapple();
+	void RetractHook(int32 HookIndex);
 
-	UFUNCTION(Server, Unreliable)
+	// Authority part of tool's tick; called directly from Tick.
 	void ServerTickGrapple(float DeltaSeconds);
-	UFUNCTION()
+	// Owning client part of tool's tick.
 	void ClientTickGrapple(float DeltaSeconds);
 	
-	UFUNCTION(NetMulticast, Unreliable)
-	void SetCableLength(float NewLength);
-	
-	UFUNCTION(NetMulticast, Unreliable)
-	void SetInstigatorVelocity(const FVector& NewVelocity);
+	// Sets length of hook projectile's visual cable on this machine.
+	void ApplyCableLength(int32 HookIndex, float NewLength);
+	// Sets velocity of tool's instigator on this machine.
+	void ApplyInstigatorVelocity(const FVector& NewVelocity);
+
+	UFUNCTION(BlueprintPure)
+	const FGrappleCableStateNetStats& GetCableStateNetStats() const { return CableStateNetStats; }
+	UFUNCTION(BlueprintPure)
+	const FGrappleCableLengthInputStats& GetCableLengthInputStats() const { return CableLengthInputStats; }
+	UFUNCTION(BlueprintPure)
+	EGrapplingHookTickState GetTickState() const { return TickState; }
+
+	// Writes the last recorded tension ticks to file (see AsgGrapple.SwingRecordFrames). Returns false if nothing was recorded.
+	bool SaveSwingRecording(const FString& FileName) const { return SwingRecorder.SaveToFile(FileName); }
+
+	// Predicted path of a shot fired now (owning client only, see bPredictTrajectory); the last point is where it lands if reachable.
+	UFUNCTION(BlueprintPure)
+	const TArray<FVector>& GetPredictedTrajectory() const { return TrajectoryPredictor.GetPoints(); }
+	UFUNCTION(BlueprintPure)
+	bool IsPredictedTrajectoryReachable() const { return TrajectoryPredictor.IsReachable(); }
+
+	int32 GetNumHooks() const { return Hooks.Num(); }
+	const TArray<FGrappleHook>& GetHooks() const { return Hooks; }
+	// Whether any hook was shot (flying or attached).
+	bool HasGrappleProjectile() const;
+	// Whether any hook is attached.
+	bool IsGrappleAttached() const;
+	// What tension of attached hook acts on; known on every machine, as it's derived from replicated anchor.
+	UFUNCTION(BlueprintPure)
+	EGrapplingHookPullMode GetPullMode(int32 HookIndex) const;
+	UFUNCTION(BlueprintPure)
+	float GetDesiredCableLength(int32 HookIndex) const { return Hooks.IsValidIndex(HookIndex) ? Hooks[HookIndex].DesiredCableLength : 0; }
 	
 	UFUNCTION()
 	void HandleInput_PrimaryFire();
 	UFUNCTION()
+	void HandleInput_SecondaryFire();
+	UFUNCTION()
 	void HandleInput_RetractCable();	
 	UFUNCTION()
 	void HandleInput_ExtendCable();
+	UFUNCTION()
+	void HandleInput_RetractSecondaryCable();
+	UFUNCTION()
+	void HandleInput_ExtendSecondaryCable();
 
 	void TickTensionForce(float DeltaSeconds, bool bPropagateOverNetwork);
 
-protected:
-	// Called when grapple projectile hits something (bound to respective event in AGrappleProjectile)
-	UFUNCTION()
-	void OnGrappleHitSurface(const FHitResult& HitResult);
+	// Collects state of attached hooks for batched simulation (see UGrapplingHookManagerSubsystem): one item with all hooks
+	// pulling instigator, and one item per hook pulling a body. Returns amount of items added.
+	int32 GatherTensionBatchItems(TArray<FGrappleTensionBatchItem>& OutItems, float DeltaSeconds);
+	// Applies result of batched simulation to instigator's movement and replicated cable state.
+	// Impulses for pulled bodies are only collected into OutPullImpulses; manager applies them together.
+	void ApplyTensionBatchItem(const FGrappleTensionBatchItem& Item, TArray<FGrapplePullImpulse>& OutPullImpulses);
 
-	// Returns actual distance along cable geometry from player to grapple point.
-	float GetDistanceToGrappleForcePoint() const;
-	// Returns point towards which tension force will be applied.
+	// Routes impacts of a projectile to given tool. Pooled projectile already bound to the tool is left as is, so shooting
+	// it again doesn't allocate a new binding.
+	static void BindImpactEvent(AGrappleProjectile::FGrappleProjectileImpactDelegate& ImpactEvent, AGrapplingHookTool* Tool);
+
+protected:
+	// Called when a projectile bound by BindImpactEvent hits something; finds the hook it belongs to.
+	void OnGrappleHitSurface(AGrappleProjectile* Projectile, const FHitResult& HitResult);
+
+	// Shoots hook if it's retracted, retracts it otherwise.
+	void HandleFireInput(int32 HookIndex);
+
+	// Updates cable turns around geometry between player and grapple points of attached hooks.
+	void UpdateCablePaths();
+
+	// Refreshes ignore lists of cached query params after instigator or projectile changed.
+	void UpdateQueryParams();
+
+	// Re-attaches grapple described by loaded item state, once tool has an instigator on the server.
+	void RestorePendingItemState();
+
+	// Records solved tension tick, if swing recording is enabled.
+	void RecordSwingFrame(const FGrappleTensionBatchItem& Item, float TimeAccumulatorBefore);
+
+	// Reads tension solver input from instigator's movement, with a constraint per attached hook pulling instigator.
+	// Returns false if there is no instigator or no such hook.
+	bool MakeTensionInput(FGrappleTensionInput& OutInput, TArray<int32, TInlineAllocator<2>>& OutHookIndices) const;
+	// Reads tension solver input from the body pulled by hook, as seen from instigator. Returns false if body doesn't simulate physics.
+	bool MakePullObjectTensionInput(int32 HookIndex, FGrappleTensionInput& OutInput) const;
+	// Fills simulation settings of batch item.
+	void InitTensionBatchItem(FGrappleTensionBatchItem& Item, float DeltaSeconds, float TimeAccumulator) const;
+	// Converts tension solver output for the pulled body into impulse limited by max pull force.
+	void AddPullImpulse(const FGrappleTensionBatchItem& Item, TArray<FGrapplePullImpulse>& OutPullImpulses) const;
+	// Applies tension solver output to instigator's movement.
+	void ApplyTensionOutput(const FGrappleTensionOutput& Output, bool bPropagateOverNetwork);
+
+	// Returns tick state matching what this machine has to do with the tool right now.
+	EGrapplingHookTickState ResolveTickState() const;
+	// Enables actor tick with interval of current state, or disables it if there is nothing to do. Should be called on every
+	// change of equipped, fired or attached state.
+	void UpdateTickState();
+
+	// Replicates pending cable state to clients, if send interval has elapsed and state has changed.
+	void SendCableState();
+
+	// Accumulates length control queries into client's target length and sends it to server at CableLengthInputSendRate.
+	void TickCableLengthInput(float DeltaSeconds);
+
+	// Runs tension locally on owning client and records predicted state.
+	void TickPredictedTension(float DeltaSeconds);
+	// Compares server-authoritative velocity with what was predicted back then, and schedules correction of the difference.
+	void ReconcilePredictedTension(const FVector& ServerVelocity);
+	// Whether this machine predicts tension instead of waiting for server velocity.
+	bool IsPredictingTension() const;
+	// Whether any attached hook pulls instigator (rather than a body).
+	bool IsPullingInstigator() const;
+
+	// Returns actual distance along hook's cable geometry from player to grapple point.
+	float GetDistanceToGrappleForcePoint(int32 HookIndex) const;
+	// Length of the real cable of the hook, as opposed to cosmetic length of its cable component.
+	float GetRopeRestLength(int32 HookIndex) const;
+	// Returns point towards which tension force of the first hook will be applied.
 	UFUNCTION(BlueprintPure)
-	FVector GetGrappleForcePoint() const;
+	FVector GetGrappleForcePoint() const { return GetHookForcePoint(0); }
+	// Returns point towards which tension force of hook will be applied.
+	UFUNCTION(BlueprintPure)
+	FVector GetHookForcePoint(int32 HookIndex) const;
 
+	// Length control input of the first hook not yet processed.
 	UFUNCTION(BlueprintPure)
 	float GetDesiredCableLengthQueries() const;
 
+	// Events of the first hook, the same as of a single hook tool.
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnGrappleFired();
 	UFUNCTION(BlueprintImplementableEvent)
@@ -126,10 +310,31 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent)
 	void OnDesiredCableLengthChanged(float NewRatio);
 
+	// Events of every hook, called along with the first hook's events above.
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHookFired(int32 HookIndex);
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHookAttached(int32 HookIndex);
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHookStartedRetracting(int32 HookIndex);
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHookFinishedRetracting(int32 HookIndex);
+
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnHookDesiredCableLengthRatioChanged(int32 HookIndex, float NewRatio);
+
+	// Called on owning client whenever predicted path of the shot is recomputed, to draw the arc preview.
+	UFUNCTION(BlueprintImplementableEvent)
+	void OnTrajectoryPredicted(bool bReachable);
+
 	float GetCableLengthControlStep() const;
 	float GetMaxCableLength() const;
 	float GetTearingDistance() const;
+	// Visual length of attached cable: a bit shorter than desired length, so cable does not appear loose when it should be tense.
+	float GetAttachedVisualCableLength(const int32 HookIndex) const { return FMath::Max(50.0f, Hooks[HookIndex].DesiredCableLength - 250); }
 	float GetInitialHookVelocity() const;
+	// Returns max force with which grapple pulls physics bodies (scaled from power upgrades).
+	float GetMaxPullForce() const;
 
 	// Returns component to which cable's end should be attached. Optionally can provide a socket with CableAttachComponentSocket property. 
 	UFUNCTION(BlueprintNativeEvent)
@@ -143,23 +348,58 @@ protected:
 	// Input context to register when grapple tool is equipped (will unregister when unequipped).
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input)
 	TObjectPtr<UFGInputMappingContext> GrappleInputContext = nullptr; 
-	// Action to shoot/return grapple projectile.
+	// Action to shoot/return projectile of the first hook.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input)
 	TObjectPtr<UInputAction> PrimaryFireAction = nullptr;
-	// Action to shrink cable's desired length.
+	// Action to shoot/return projectile of the second hook (tools with more than one hook only).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input)
+	TObjectPtr<UInputAction> SecondaryFireAction = nullptr;
+	// Action to shrink cable's desired length (of the first hook, or of every hook without secondary cable actions).
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input)
 	TObjectPtr<UInputAction> RetractCableAction = nullptr;
-	// Action to prolong cable's desired length.
+	// Action to prolong cable's desired length (of the first hook, or of every hook without secondary cable actions).
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input)
 	TObjectPtr<UInputAction> ExtendCableAction = nullptr;
+	// Actions to shrink/prolong desired length of the second hook's cable (tools with more than one hook only).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input)
+	TObjectPtr<UInputAction> RetractSecondaryCableAction = nullptr;
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category=Input)
+	TObjectPtr<UInputAction> ExtendSecondaryCableAction = nullptr;
 
 	// Widget that will appear on screen when player is aiming at reachable surface.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple")
 	TSubclassOf<UUserWidget> CrosshairHighlightWidgetClass;
+	// How many times per second reachability of aimed surface is checked for crosshair highlight.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair", meta=(ClampMin=1))
+	float CrosshairUpdateRate = 20;
+	// Aim direction change (degrees) below which reachability is not checked again.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair", meta=(ClampMin=0))
+	float CrosshairAimAngleThreshold = 0.5f;
+	// Shooting source movement below which reachability is not checked again.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair", meta=(ClampMin=0))
+	float CrosshairSourceMoveThreshold = 25;
+	// Reachability is checked at least this often even if aim doesn't change, as world around may (seconds).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair", meta=(ClampMin=0))
+	float CrosshairMaxStaleness = 1;
+	// Whether reachability is checked along predicted ballistic path of the shot rather than a straight line.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair")
+	bool bPredictTrajectory = true;
+	// Flight time covered by one traced segment of predicted path (seconds).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair", meta=(EditCondition="bPredictTrajectory", ClampMin=0.01))
+	float TrajectoryTimeStep = 0.1f;
+	// Longest flight predicted; shots flying longer are considered to miss (seconds).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair", meta=(EditCondition="bPredictTrajectory", ClampMin=0))
+	float TrajectoryMaxTime = 3;
+	// Segments of predicted path traced per tick, so prediction is spread over several frames.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Crosshair", meta=(EditCondition="bPredictTrajectory", ClampMin=1))
+	int32 TrajectorySegmentsPerTick = 16;
 	
 	// Projectile that will be shot from the tool.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Projectile")
 	TSubclassOf<AGrappleProjectile> GrappleProjectileClass = nullptr;
+	// Amount of independent hooks, each with its own projectile and cable length. Tensions of all hooks are solved together.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Projectile", meta=(ClampMin=1, ClampMax=8))
+	int32 NumHooks = 1;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Upgrades")
 	FGrapplingHookUpgradesChain UpgradesLength;
@@ -179,35 +419,144 @@ protected:
 	// Cable gravity multiplier applied after projectile hits something.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Cable")
 	float CableGravityScaleAfterHit = 3;
+	// Whether tension is simulated in fixed time steps (frame rate independent) rather than once per tick with tick's delta time.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Simulation")
+	bool bUseFixedTimestepTension = true;
+	// Duration of a single tension simulation step, in seconds.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Simulation", meta=(EditCondition="bUseFixedTimestepTension", ClampMin=0.001))
+	float TensionFixedTimestep = 1.0f / 60.0f;
+	// Maximum amount of tension simulation steps per tick. Time beyond that (hitches) is not simulated.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Simulation", meta=(EditCondition="bUseFixedTimestepTension", ClampMin=1))
+	int32 MaxTensionSubsteps = 8;
+
+	// How many times per second cable state (visual length and velocity corrections) may be replicated to clients.
+	// Zero means every tick.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Network", meta=(ClampMin=0))
+	float CableStateSendRate = 20;
+
+	// How many times per second owning client may send cable length updates to server.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Network", meta=(ClampMin=1))
+	float CableLengthInputSendRate = 30;
+	// Shot whose projectile hasn't replicated to owning client within round trip time plus this (seconds) is considered
+	// rejected by server, and the hook is returned to the tool.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Network", meta=(ClampMin=0))
+	float ShotConfirmationTimeout = 0.5f;
+
+	// Whether owning client simulates tension locally and reconciles with server, instead of only applying velocity sent by server.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Network")
+	bool bPredictTension = true;
+	// Which part of remaining prediction error is corrected per second.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Network", meta=(EditCondition="bPredictTension", ClampMin=0))
+	float PredictionCorrectionRate = 10;
+	// Prediction errors larger than this (velocity difference) are corrected immediately instead of smoothly.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Network", meta=(EditCondition="bPredictTension", ClampMin=0))
+	float PredictionSnapThreshold = 1500;
+
+	// Tick interval while owning client only updates crosshair highlight (seconds, 0 - every frame).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Tick", meta=(ClampMin=0))
+	float CrosshairTickInterval = 0.05f;
+	// Tick interval while projectile is flying (seconds, 0 - every frame).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Tick", meta=(ClampMin=0))
+	float FlyingTickInterval = 0;
+	// Tick interval of owning client while grapple is attached (seconds, 0 - every frame).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Tick", meta=(ClampMin=0))
+	float AttachedTickInterval = 0;
+
+	// Whether grapple hooked to physics simulating body (dropped crate, vehicle) pulls the body instead of the player.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Pull")
+	bool bPullSimulatingObjects = true;
+	// Max force pulling bodies, per unit of UpgradesPower value (kg*cm/s^2 per cm/s of initial hook velocity).
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Pull", meta=(EditCondition="bPullSimulatingObjects", ClampMin=0))
+	float PullForcePerPower = 50;
+
+	// How attached cable wraps around geometry between player and grapple point.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Grapple|Cable")
+	FGrappleCableWrapSettings CableWrapSettings;
 
 private:
 	// Turn grapple-specific inputs on/off 
 	void SetInputContextRegistered(AFGPlayerController* Controller, const bool bRegistered);
 
+	// Returns hooks whose shots server has not confirmed in time back to the tool. Owning client only.
+	void TickUnconfirmedShots();
+	// Requests asynchronous reachability trace for crosshair highlight, if aim has changed enough since the last one.
+	void TickCrosshairHighlight();
+	void OnCrosshairTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	void OnTrajectoryTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+	// Returns initial state of a shot fired now, computed the same way as server does.
+	FGrappleTrajectoryParams MakeTrajectoryParams(const FVector& Source, const FVector& Direction) const;
+	void SetCrosshairHighlightVisible(bool bVisible);
+
 	UFUNCTION()
-	void OnRep_GrappleProjectile();
-	UFUNCTION()
-	void OnRep_GrappleAttached();
+	void OnRep_Hooks(const TArray<FGrappleHook>& PreviousHooks);
 	UFUNCTION()
-	void OnRep_DesiredCableLength();
+	void OnRep_CableState();
+
+	// Reactions to changes of hook's replicated state; server calls these itself after changing the state.
+	void OnHookProjectileChanged(int32 HookIndex);
+	void OnHookAnchorChanged(int32 HookIndex);
+	void OnHookAttachedChanged(int32 HookIndex);
+	void OnHookDesiredCableLengthChanged(int32 HookIndex);
+	// Drops cable path and simulation history of hook's previous attachment (and instigator's, if no other hook holds it).
+	void ResetHookSimulation(int32 HookIndex);
+
+	// Call per-hook Blueprint event, and for the first hook its single hook counterpart as well.
+	void NotifyHookFired(int32 HookIndex);
+	void NotifyHookAttached(int32 HookIndex);
+	// Hook is back in the tool at once, so both retracting events are called together.
+	void NotifyHookRetracted(int32 HookIndex);
+	void NotifyHookCableLengthChanged(int32 HookIndex, float NewRatio);
+
+	// Stacks length control input for hook's cable, if attached. Without secondary cable actions, the first hook's
+	// input steers every attached hook.
+	void AddCableLengthControlQuery(int32 HookIndex, float Query);
+
+	// Whether any hook can be shot.
+	bool HasRetractedHook() const;
+	// Owning client's ping, in seconds.
+	float GetRoundTripTime() const;
+
+	// Returns point the hook's cable is hooked to: anchor, once attached, or projectile while it's flying.
+	FVector GetAnchorLocation(int32 HookIndex) const;
 	
 private:
-	// Grapple projectile that was shot from this tool.
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_GrappleProjectile)
-	TObjectPtr<AGrappleProjectile> GrappleProjectile = nullptr;
-
-	// Desired length is length at which tension force will be applied to player.
-	// When it is larger than actual length, tension is not applied.
-	// When it is smaller than actual length, additional pulling force is applied.  
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_DesiredCableLength)
-	float DesiredCableLength = 0;
-
-	// Stacked length control inputs; will be processed and zerofied at Tick.
-	float DesiredCableLengthControlQuery = 0;
-
-	// Whether grapple projectile is sticked to something.
-	UPROPERTY(Transient, ReplicatedUsing=OnRep_GrappleAttached)
-	bool bGrappleAttached = false;
+	// All hooks of the tool (NumHooks of them, the array is never resized afterwards).
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_Hooks)
+	TArray<FGrappleHook> Hooks;
+	// Last tension ticks on this machine, for offline replay of swings.
+	FGrappleSwingRecorder SwingRecorder;
+
+	// Item state loaded from save, waiting for the tool to be equipped to restore attached hooks.
+	FGrapplingHookItemState PendingItemState;
+
+	// Last cable state sent by server.
+	UPROPERTY(Transient, ReplicatedUsing=OnRep_CableState)
+	FGrappleCableState CableState;
+	// Cable state collected during current server tick, sent with respect to CableStateSendRate.
+	FGrappleCableState PendingCableState;
+	float LastCableStateSendTime = -1;
+
+	FGrappleCableStateNetStats CableStateNetStats;
+	// Start of current bytes per second measurement window, and bytes sent during it.
+	float CableStateNetStatsWindowStart = 0;
+	int32 CableStateNetStatsWindowBytes = 0;
+	// Reused to measure size of sent cable states, so its buffer is allocated once.
+	FNetBitWriter CableStateSizeWriter{nullptr, 256};
+
+	// States predicted by owning client, used to reconcile with server.
+	FGrapplePredictionHistory PredictionHistory;
+	// Part of prediction error not yet applied to instigator's velocity.
+	FVector PendingPredictionCorrection = FVector::ZeroVector;
+
+	// Time not yet simulated by fixed timestep tension simulation of instigator.
+	float TensionTimeAccumulator = 0;
+
+	// Owning client time of the last shot of any hook sent to server; mirrors server's rate limit.
+	float LastClientShootTime = -1;
+
+	// When owning client last sent length updates of its hooks (see FGrappleHook for per-hook input state).
+	float LastCableLengthInputSendTime = -1;
+	FGrappleCableLengthInputStats CableLengthInputStats;
 
 	// Whether input actions were bound to their respective delegates
 	bool bInputsBound = false;
@@ -216,9 +565,25 @@ private:
 	// (5.6 Enhanced Input replaced AFGPlayerController::SetMappingContextBound with a handle-based API)
 	FBoundMappingContextHandle GrappleInputContextHandle;
 
-	// Local flag indicating whether projectile should be located inside the tool or not.
-	bool bRetracted = true;
+	// What actor tick is scheduled for on this machine (see UpdateTickState).
+	EGrapplingHookTickState TickState = EGrapplingHookTickState::Idle;
 
 	UPROPERTY(Transient)
 	TObjectPtr<UUserWidget> CrosshairHighlightWidget;
+	bool bCrosshairHighlightVisible = false;
+
+	// Query params of aim traces (crosshair and shot), ignoring instigator.
+	FCollisionQueryParams AimQueryParams;
+	// Query params of cable path sweeps, ignoring instigator and projectile.
+	FCollisionQueryParams CablePathQueryParams;
+
+	// Crosshair reachability trace state. Result is consumed when async trace completes (next frame).
+	FTraceDelegate CrosshairTraceDelegate;
+	bool bCrosshairTracePending = false;
+	float LastCrosshairTraceTime = -1;
+	FVector LastCrosshairTraceSource = FVector::ZeroVector;
+	FVector LastCrosshairTraceDirection = FVector::ZeroVector;
+
+	FGrappleTrajectoryPredictor TrajectoryPredictor;
+	FTraceDelegate TrajectoryTraceDelegate;
 };
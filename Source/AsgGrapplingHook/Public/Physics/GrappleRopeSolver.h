@@ -0,0 +1,57 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+// Timing of the last rope solver step.
+struct FGrappleRopeSolverStats
+{
+	int32 NumParticles = 0;
+	int32 Iterations = 0;
+	double StepMilliseconds = 0;
+
+	// Particles times constraint iterations processed per millisecond.
+	double GetParticleIterationsPerMs() const { return StepMilliseconds > 0 ? NumParticles * Iterations / StepMilliseconds : 0; }
+};
+
+// Verlet rope simulation with both ends pinned, independent from any engine objects.
+// Particles are kept as structure of arrays (positions relative to the rope start, in float) and distance constraints
+// are relaxed four segments at a time with SIMD; every relaxation pass is Jacobi-style, so segments don't depend on each other within a pass.
+class ASGGRAPPLINGHOOK_API FGrappleRopeSolver
+{
+public:
+	// Places NumParticles (at least 2) evenly on a straight line between Start and End.
+	void Initialize(int32 NumParticles, const FVector& Start, const FVector& End);
+
+	// Advances simulation by DeltaSeconds. First and last particles are pinned to Start and End,
+	// RestLength is total length of the rope when it's not stretched.
+	void Step(float DeltaSeconds, const FVector& Start, const FVector& End, float RestLength, int32 Iterations, const FVector& Gravity);
+
+	int32 GetNumParticles() const { return NumParticles; }
+	FVector GetParticleLocation(int32 Index) const;
+	void GetParticleLocations(TArray<FVector>& OutLocations) const;
+
+	const FGrappleRopeSolverStats& GetLastStepStats() const { return LastStepStats; }
+
+	// Fraction of velocity lost every step.
+	float Damping = 0.02f;
+
+private:
+	// Moves all particles so their positions are relative to NewOrigin.
+	void Rebase(const FVector& NewOrigin);
+	void Integrate(float DeltaSeconds, const FVector3f& Gravity);
+	void RelaxConstraints(float SegmentLength);
+	void Pin(const FVector3f& Start, const FVector3f& End);
+
+private:
+	int32 NumParticles = 0;
+	// Arrays are padded, so SIMD loads past the last particle stay within allocation.
+	TArray<float> PositionX, PositionY, PositionZ;
+	TArray<float> PreviousX, PreviousY, PreviousZ;
+	// Per segment correction computed during relaxation pass.
+	TArray<float> CorrectionX, CorrectionY, CorrectionZ;
+
+	// World location particle positions are relative to (rope start at the time of last step).
+	FVector Origin = FVector::ZeroVector;
+
+	FGrappleRopeSolverStats LastStepStats;
+};
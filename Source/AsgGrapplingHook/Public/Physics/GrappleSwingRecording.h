@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Physics/GrappleTensionSolver.h"
+
+// One tick of tension simulation of a single grapple, as solved in game: solver input and settings, and its result.
+struct FGrappleSwingFrame
+{
+	// Solved item: input as gathered, output and accumulator (time left after solving) as applied.
+	FGrappleTensionBatchItem Item;
+	// Fixed timestep accumulator before solving.
+	float TimeAccumulatorBefore = 0;
+	// EMovementMode of instigator when input was gathered.
+	uint8 MovementMode = 0;
+};
+
+// Preallocated ring buffer keeping the last swing frames of a grapple tool. Recording a frame never allocates.
+// Frames are written to a compact binary file on demand (see AsgGrapple.SaveSwings) for offline replay.
+class ASGGRAPPLINGHOOK_API FGrappleSwingRecorder
+{
+public:
+	// Allocates buffer for Capacity frames and clears recorded ones.
+	void Initialize(int32 InCapacity);
+	int32 GetCapacity() const { return Capacity; }
+
+	void Record(const FGrappleSwingFrame& Frame);
+	void Reset();
+
+	int32 Num() const { return Frames.Num(); }
+	// Copies recorded frames from the oldest to the newest.
+	void GetFrames(TArray<FGrappleSwingFrame>& OutFrames) const;
+
+	// Writes recorded frames to file. Returns false if there is nothing to write or file can't be written.
+	bool SaveToFile(const FString& FileName) const;
+	static bool LoadFromFile(const FString& FileName, TArray<FGrappleSwingFrame>& OutFrames);
+
+private:
+	TArray<FGrappleSwingFrame> Frames;
+	int32 Capacity = 0;
+	// Index of the oldest frame once buffer is full.
+	int32 Head = 0;
+};
+
+// Result of re-running tension solver against a recording.
+struct FGrappleSwingReplayResult
+{
+	int32 NumFrames = 0;
+	// Frames whose replayed output differs from recorded one.
+	int32 NumMismatches = 0;
+	int32 FirstMismatchFrame = INDEX_NONE;
+	// Largest difference between replayed and recorded velocity.
+	float MaxVelocityError = 0;
+	// Time spent solving all frames, usable as a benchmark of the solver.
+	double SolveSeconds = 0;
+};
+
+// Offline player of swing recordings: solves every recorded frame again and diffs the output with recorded one.
+// Frames are replayed independently (each from its recorded input), so a single divergence doesn't cascade.
+struct ASGGRAPPLINGHOOK_API FGrappleSwingReplay
+{
+	static FGrappleSwingReplayResult Run(const TArray<FGrappleSwingFrame>& Frames, float VelocityTolerance = 0.1f);
+};
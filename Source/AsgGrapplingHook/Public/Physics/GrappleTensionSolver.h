@@ -0,0 +1,83 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+// Single cable holding a grappled character.
+struct FGrappleTensionConstraint
+{
+	// Point towards which tension force is applied (grapple point or the closest cable turn).
+	FVector ForcePoint = FVector::ZeroVector;
+	// Actual length of cable along its geometry.
+	float CableLength = 0;
+	// Length at which tension starts to be applied.
+	float DesiredCableLength = 0;
+};
+
+// Constraints of all hooks holding one character. Inline storage covers dual hook, so gathering never allocates for it.
+using FGrappleTensionConstraints = TArray<FGrappleTensionConstraint, TInlineAllocator<2>>;
+
+// State of a grappled character required to compute tension. Plain data, does not reference any engine objects.
+struct FGrappleTensionInput
+{
+	FVector Velocity = FVector::ZeroVector;
+	FVector CharacterLocation = FVector::ZeroVector;
+	// Cables holding the character; all of them are solved together.
+	FGrappleTensionConstraints Constraints;
+	// Whether character is walking on the ground (has friction) rather than being in the air.
+	bool bWalking = false;
+	// Normal of the floor character is walking on; only meaningful when walking.
+	FVector FloorNormal = FVector::UpVector;
+};
+
+struct FGrappleTensionOutput
+{
+	FVector Velocity = FVector::ZeroVector;
+	// Whether cable was tense, i.e. velocity was altered at all.
+	bool bTense = false;
+	// Whether walking character should take off the ground and start falling.
+	bool bTakeOff = false;
+};
+
+// Everything needed to simulate one attached grapple for one tick, so many grapples can be processed in a batch.
+struct FGrappleTensionBatchItem
+{
+	FGrappleTensionInput Input;
+	float DeltaSeconds = 0;
+	// Cable length over desired length at which the cable tears.
+	float TearingDistance = 0;
+	bool bFixedTimestep = true;
+	float FixedTimestep = 0;
+	int32 MaxSubsteps = 0;
+	// Time accumulated by fixed timestep simulation before this tick; time left for the next one after solving.
+	float TimeAccumulator = 0;
+
+	FGrappleTensionOutput Output;
+	// Whether a cable was overstretched and has to be retracted (no tension is applied then).
+	bool bTear = false;
+	// Index of the first overstretched constraint, or INDEX_NONE.
+	int32 TornConstraint = INDEX_NONE;
+
+	// Not used by solver: hook of the tool every constraint belongs to, and whether item pulls hooked body rather than
+	// the tool's instigator.
+	TArray<int32, TInlineAllocator<2>> HookIndices;
+	bool bPullsBody = false;
+};
+
+// Rope tension math of grappling hook, independent from movement components and actors,
+// so it can be run for any amount of characters and profiled without the game.
+// Several cables holding one character are resolved in one constraint solve rather than one after another,
+// as sequential velocity overwrites would fight each other.
+struct ASGGRAPPLINGHOOK_API FGrappleTensionSolver
+{
+	// Computes velocity of grappled character after DeltaSeconds of tension of all its cables.
+	static FGrappleTensionOutput Step(const FGrappleTensionInput& Input, float DeltaSeconds);
+
+	// Runs as many fixed FixedTimestep steps as fit into accumulated time, predicting character location between them,
+	// so the result does not depend on frame rate. Time that didn't fit into a step is carried over in InOutAccumulator;
+	// if no full step fits at all (frame rate above 1/FixedTimestep), accumulated time is run as one shorter step.
+	// At most MaxSubsteps are run per call; time beyond that is dropped, so hitches do not turn into slingshots.
+	static FGrappleTensionOutput Integrate(const FGrappleTensionInput& Input, float DeltaSeconds, float FixedTimestep, int32 MaxSubsteps, float& InOutAccumulator);
+
+	// Checks tearing and runs tension for a batch item. Touches nothing but the item, so items can be solved in parallel.
+	static void Solve(FGrappleTensionBatchItem& Item);
+};
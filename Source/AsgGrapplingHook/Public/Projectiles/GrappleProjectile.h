@@ -2,9 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "FGProjectile.h"
+#include "Equipment/GrappleAnchor.h"
+#include "Physics/GrappleRopeSolver.h"
+#include "Subsystems/GrappleCableLODSubsystem.h"
 #include "GrappleProjectile.generated.h"
 
 class UCableComponent;
+class USplineMeshComponent;
 
 UCLASS(Abstract)
 class ASGGRAPPLINGHOOK_API AGrappleProjectile : public AFGProjectile
@@ -22,22 +26,93 @@ public:
 	TObjectPtr<UMaterialInterface> CableMaterial;
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	TObjectPtr<UMaterialInterface> CableMaterial1P;
+
+	// Whether rope is simulated by FGrappleRopeSolver instead of CableComponent. Cable component is hidden then,
+	// and rope is rendered by RopeSegmentMesh stretched between every two particles.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Rope")
+	bool bUseRopeSolver = false;
+	// Mesh of one rope segment, authored along X axis with thickness of 1 unit (scaled by cable width).
+	// Rope solver is not used without it, as nothing would render the rope.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Rope", meta=(EditCondition="bUseRopeSolver"))
+	TObjectPtr<UStaticMesh> RopeSegmentMesh;
+	// Constraint relaxation iterations of rope solver at full LOD.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Rope", meta=(EditCondition="bUseRopeSolver", ClampMin=1))
+	int32 RopeSolverIterations = 8;
 	
-	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFGOnProjectileImpact, const FHitResult&, HitResult);
-	FFGOnProjectileImpact OnProjectileImpactEvent;
+	// Native single-cast without payload, so it stays bound while the same tool keeps shooting this pooled projectile.
+	DECLARE_DELEGATE_TwoParams(FGrappleProjectileImpactDelegate, AGrappleProjectile* /*Projectile*/, const FHitResult& /*HitResult*/);
+	FGrappleProjectileImpactDelegate OnProjectileImpactEvent;
 
 public:
 	void SetFirstPersonCableMaterial();
+	void SetThirdPersonCableMaterial();
+
+	// Brings pooled projectile back to life at given location, moving with given velocity.
+	void ActivateFromPool(const FVector& Location, const FVector& InitialVelocity);
+	// Stops projectile at grapple anchor and locally attaches it to anchor's component, so it follows moving targets
+	// without replicating its transform. Called on every machine once anchor is known.
+	void SettleAtAnchor(const FGrappleAnchor& Anchor);
+	// Detaches projectile from anchor's component and lets its movement replicate again.
+	void ReleaseAnchor();
+	// Stops, hides and makes projectile net dormant until it's taken from the pool again.
+	void DeactivateToPool();
+
+	// Adjusts cable simulation detail. Cable is only re-initialized when tier actually changes.
+	void SetCableLOD(EGrappleCableLOD NewLOD);
+	EGrappleCableLOD GetCableLOD() const { return CableLOD; }
+	// Whether whatever represents the cable on screen was rendered within given amount of seconds.
+	bool WasCableRecentlyRendered(float Tolerance) const;
+
+	UFUNCTION(BlueprintPure, Category="Rope")
+	const TArray<FVector>& GetRopeParticleLocations() const { return RopeParticleLocations; }
+	const FGrappleRopeSolver& GetRopeSolver() const { return RopeSolver; }
+	bool IsUsingRopeSolver() const { return bRopeSolverActive; }
+	// Length of the real cable (see AGrapplingHookTool::GetRopeRestLength). Rope is never shorter than distance between its ends.
+	void SetRopeRestLength(const float NewRestLength) { RopeRestLength = NewRestLength; }
+
+	//~ Begin AActor interface
+	virtual void Tick(float DeltaSeconds) override;
+	virtual bool IsNetRelevantFor(const AActor* RealViewer, const AActor* ViewTarget, const FVector& SrcLocation) const override;
+	virtual float GetNetPriority(const FVector& ViewPos, const FVector& ViewDir, AActor* Viewer, AActor* ViewTarget,
+		UActorChannel* InChannel, float Time, bool bLowBandwidth) override;
+	//~ End AActor interface
 	
 protected:
 	//~ Begin AActor interface
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	//~ End AActor interface
 	
 	//~ Begin AFGProjectile interface
 	virtual void OnImpact_Native(const FHitResult& HitResult) override;
 	//~ End AFGProjectile interface
 
+	// Called after rope solver has updated particle locations, for effects on top of rendered rope.
+	UFUNCTION(BlueprintImplementableEvent, Category="Rope")
+	void OnRopeSimulated();
+
 private:
 	bool bWasMaterial1P = false;
+
+	EGrappleCableLOD CableLOD = EGrappleCableLOD::Full;
+	// Cable simulation settings as authored, restored at full LOD.
+	int32 AuthoredNumSegments = 0;
+	int32 AuthoredSolverIterations = 0;
+
+	// Whether rope solver is used (bUseRopeSolver with a mesh to render it).
+	bool bRopeSolverActive = false;
+	FGrappleRopeSolver RopeSolver;
+	TArray<FVector> RopeParticleLocations;
+	float RopeRestLength = 0;
+	// One per rope segment, positioned in world space.
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USplineMeshComponent>> RopeSegmentComponents;
+
+private:
+	// Returns location of cable's end attached to the tool.
+	FVector GetCableEndLocation() const;
+	void CreateRopeSegmentComponents();
+	// Bends segment meshes along simulated particles.
+	void UpdateRopeSegmentComponents();
+	void SetRopeMaterial(UMaterialInterface* Material);
 };
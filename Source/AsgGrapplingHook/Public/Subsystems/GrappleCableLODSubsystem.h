@@ -0,0 +1,77 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GrappleCableLODSubsystem.generated.h"
+
+class AGrappleProjectile;
+
+// Level of detail of grapple cable simulation.
+UENUM(BlueprintType)
+enum class EGrappleCableLOD : uint8
+{
+	// Simulated as authored in projectile.
+	Full,
+	// Fewer segments and solver iterations.
+	Reduced,
+	// Single segment, i.e. a straight line.
+	Straight,
+	// Not simulated at all (not rendered, or nothing renders on this machine).
+	Frozen
+};
+
+USTRUCT(BlueprintType)
+struct FGrappleCableLODStats
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly)
+	int32 Full = 0;
+	UPROPERTY(BlueprintReadOnly)
+	int32 Reduced = 0;
+	UPROPERTY(BlueprintReadOnly)
+	int32 Straight = 0;
+	UPROPERTY(BlueprintReadOnly)
+	int32 Frozen = 0;
+};
+
+// Assigns simulation LOD tiers to grapple cables by distance to local viewer, visibility and per-tier budgets.
+UCLASS()
+class ASGGRAPPLINGHOOK_API UGrappleCableLODSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGrappleCableLODSubsystem* Get(const UWorld* World);
+
+	void RegisterCable(AGrappleProjectile* Projectile);
+	void UnregisterCable(AGrappleProjectile* Projectile);
+
+	//~ Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject interface
+
+	UFUNCTION(BlueprintPure, Category="Grapple|Cable")
+	const FGrappleCableLODStats& GetLODStats() const { return Stats; }
+
+protected:
+	//~ Begin UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem interface
+
+private:
+	void UpdateLODs();
+
+private:
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AGrappleProjectile>> Cables;
+
+	// Scratch buffer of (squared distance to viewer, index in Cables), kept to avoid reallocating every update.
+	TArray<TPair<double, int32>> SortedCables;
+
+	float TimeUntilUpdate = 0;
+
+	FGrappleCableLODStats Stats;
+};
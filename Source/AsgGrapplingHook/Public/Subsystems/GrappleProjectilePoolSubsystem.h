@@ -0,0 +1,63 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GrappleProjectilePoolSubsystem.generated.h"
+
+class AGrappleProjectile;
+
+USTRUCT(BlueprintType)
+struct FGrappleProjectilePoolStats
+{
+	GENERATED_BODY()
+
+public:
+	// Projectiles created because there was no dormant one of requested class.
+	UPROPERTY(BlueprintReadOnly)
+	int32 Spawned = 0;
+	// Projectiles taken from the pool instead of spawning new ones.
+	UPROPERTY(BlueprintReadOnly)
+	int32 Reused = 0;
+	// Projectiles returned to the pool.
+	UPROPERTY(BlueprintReadOnly)
+	int32 Released = 0;
+	// Projectiles destroyed because the pool was full.
+	UPROPERTY(BlueprintReadOnly)
+	int32 Destroyed = 0;
+	// Projectiles currently waiting in the pool.
+	UPROPERTY(BlueprintReadOnly)
+	int32 Dormant = 0;
+};
+
+// Server-side pool of grapple projectiles. Retracted projectiles are hidden and made net dormant instead of destroyed,
+// so shooting again neither spawns an actor with its cable component nor replicates actor creation to clients.
+UCLASS()
+class ASGGRAPPLINGHOOK_API UGrappleProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGrappleProjectilePoolSubsystem* Get(const UWorld* World);
+
+	// Returns active projectile of given class located at Location and moving with InitialVelocity.
+	AGrappleProjectile* Acquire(TSubclassOf<AGrappleProjectile> ProjectileClass, const FVector& Location, const FVector& InitialVelocity);
+	// Puts projectile to sleep until it's acquired again (or destroys it, if the pool is full).
+	void Release(AGrappleProjectile* Projectile);
+
+	UFUNCTION(BlueprintPure, Category="Grapple|Projectile")
+	const FGrappleProjectilePoolStats& GetPoolStats() const { return Stats; }
+
+protected:
+	//~ Begin UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem interface
+
+private:
+	// Maximum amount of dormant projectiles kept in the pool.
+	static constexpr int32 MaxDormantProjectiles = 32;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AGrappleProjectile>> DormantProjectiles;
+
+	FGrappleProjectilePoolStats Stats;
+};
@@ -0,0 +1,98 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Physics/GrappleTensionSolver.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GrapplingHookManagerSubsystem.generated.h"
+
+class AGrapplingHookTool;
+struct FBodyInstance;
+
+// Impulse pulling a physics body towards its grapple's instigator, collected from all tools to be applied together.
+struct FGrapplePullImpulse
+{
+	FBodyInstance* Body = nullptr;
+	FVector Impulse = FVector::ZeroVector;
+	// World location impulse is applied at (grapple anchor).
+	FVector Location = FVector::ZeroVector;
+};
+
+// Server-side simulation of all attached grapples in the world. Every tick, state of registered tools is gathered into
+// a contiguous array on game thread, tearing and tension are solved for all of them in parallel, and results are
+// written back to tools and their instigators' movement on game thread again. Grapples pulling physics bodies rather than
+// their instigators produce impulses, which are applied to all bodies at once under a single physics scene write lock.
+UCLASS()
+class ASGGRAPPLINGHOOK_API UGrapplingHookManagerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGrapplingHookManagerSubsystem* Get(const UWorld* World);
+
+	// Solves gathered items in parallel. Plain data only, so it is safe off game thread and usable without a world.
+	static void SolveBatch(TArrayView<FGrappleTensionBatchItem> Items);
+
+	void RegisterTool(AGrapplingHookTool* Tool);
+	void UnregisterTool(AGrapplingHookTool* Tool);
+
+	int32 GetNumRegisteredTools() const { return Tools.Num(); }
+
+	// Network traffic accounting for "stat AsgGrapple" (per second rates are updated once a second).
+	void RecordRpc() { ++RpcsInWindow; }
+	void RecordRejectedRpc();
+	int32 GetNumRejectedRpcs() const { return RejectedRpcs; }
+	void RecordCableStateUpdate(const int32 Bytes) { ++CableStateUpdatesInWindow; CableStateBytesInWindow += Bytes; }
+	float GetRpcsPerSecond() const { return RpcsPerSecond; }
+	float GetCableStateUpdatesPerSecond() const { return CableStateUpdatesPerSecond; }
+	float GetCableStateBytesPerSecond() const { return CableStateBytesPerSecond; }
+
+	// Prints per-player summary of all grapple tools in the world.
+	void DumpStats(FOutputDevice& Ar) const;
+	// Prints which grapple projectiles every client connection currently receives. Server only.
+	void DumpRelevancy(FOutputDevice& Ar) const;
+	// Writes swing recordings of all grapple tools in the world into Saved/GrappleSwings, one file per player.
+	void SaveSwingRecordings(FOutputDevice& Ar) const;
+
+	//~ Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	//~ End FTickableGameObject interface
+
+protected:
+	//~ Begin UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem interface
+
+private:
+	// Batches smaller than this are solved on game thread, as dispatching tasks would cost more than solving.
+	static constexpr int32 MinParallelBatchSize = 8;
+
+	TArray<TWeakObjectPtr<AGrapplingHookTool>> Tools;
+
+	// Gathered items and their tools (same indices). Kept between ticks to avoid reallocation.
+	TArray<FGrappleTensionBatchItem> BatchItems;
+	TArray<AGrapplingHookTool*> BatchTools;
+	TArray<FGrapplePullImpulse> PullImpulses;
+
+	float NetRatesWindowStart = 0;
+	int32 RpcsInWindow = 0;
+	int32 CableStateUpdatesInWindow = 0;
+	int32 CableStateBytesInWindow = 0;
+	float RpcsPerSecond = 0;
+	float CableStateUpdatesPerSecond = 0;
+	float CableStateBytesPerSecond = 0;
+	// Calls dropped by server validation since world start.
+	int32 RejectedRpcs = 0;
+
+	// How many times budgets from UAsgGrapplingHookSettings were exceeded (frames for tension batch, seconds for traffic).
+	int32 TensionBatchBudgetOverruns = 0;
+	int32 CableStateTrafficBudgetOverruns = 0;
+	float LastBudgetWarningTime = -1;
+
+private:
+	void UpdateNetRates();
+	// Applies impulses collected by write back of the batch to their bodies.
+	void ApplyPullImpulses();
+	// Counts budget overrun and logs a warning, unless one was logged recently.
+	void ReportBudgetOverrun(int32& Overruns, const TCHAR* BudgetName, float Value, float Budget);
+};
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GrapplingHookUpgradesSubsystem.generated.h"
+
+class AFGSchematicManager;
+class UFGSchematic;
+
+// Counters describing how grappling hook upgrade chains were resolved in a world.
+USTRUCT(BlueprintType)
+struct FGrapplingHookUpgradesCacheStats
+{
+	GENERATED_BODY()
+
+public:
+	// Lookups answered by already resolved value.
+	UPROPERTY(BlueprintReadOnly)
+	int64 Hits = 0;
+	// Lookups that had to walk upgrades chain and query schematic manager.
+	UPROPERTY(BlueprintReadOnly)
+	int64 Misses = 0;
+	// How many times all resolved values were dropped (schematic purchased or schematic manager changed).
+	UPROPERTY(BlueprintReadOnly)
+	int64 Invalidations = 0;
+};
+
+// Keeps track of the world's purchased schematics "generation", so upgrade chains can cache their resolved values
+// and only walk the schematics again after something was purchased.
+UCLASS()
+class ASGGRAPPLINGHOOK_API UGrapplingHookUpgradesSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UGrapplingHookUpgradesSubsystem* Get(const UWorld* World);
+
+	//~ Begin UWorldSubsystem interface
+	virtual void Deinitialize() override;
+	//~ End UWorldSubsystem interface
+
+	// Returns current generation of purchased schematics. Values resolved under the same generation are still valid.
+	// Zero means that nothing can be cached right now (schematic manager doesn't exist yet).
+	uint32 GetGeneration();
+
+	void RecordHit() { ++Stats.Hits; }
+	void RecordMiss() { ++Stats.Misses; }
+
+	// Drops all cached upgrade values of this world.
+	void Invalidate();
+
+	UFUNCTION(BlueprintPure, Category="Grapple|Upgrades")
+	const FGrapplingHookUpgradesCacheStats& GetCacheStats() const { return Stats; }
+
+protected:
+	//~ Begin UWorldSubsystem interface
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	//~ End UWorldSubsystem interface
+
+private:
+	UFUNCTION()
+	void OnSchematicPurchased(TSubclassOf<UFGSchematic> Schematic);
+
+private:
+	// Schematic manager whose purchase event we are listening to.
+	TWeakObjectPtr<AFGSchematicManager> SchematicManager;
+
+	uint32 Generation = 0;
+
+	FGrapplingHookUpgradesCacheStats Stats;
+};